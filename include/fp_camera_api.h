@@ -0,0 +1,53 @@
+#ifndef __FP_CAMERA_API_H__
+#define __FP_CAMERA_API_H__
+
+/*
+ * Public API of bk_first_person_mode for other mods.
+ *
+ * Copy this header into your mod and subscribe to the events with
+ *   RECOMP_CALLBACK("bk_first_person_mode", fp_on_camera_finalize)
+ *   void my_handler(const FpCameraState *state) { ... }
+ * or poll with fp_camera_get_state().  The state is written by this mod
+ * once per game tick and must be treated as read-only.
+ */
+
+#include "modding.h"
+#include "PR/ultratypes.h"
+
+/* Which camera placement the eye is using (FpCameraState.profile) */
+#define FP_PROFILE_NONE          0   /* first person inactive          */
+#define FP_PROFILE_BANJO         1
+#define FP_PROFILE_TALON_TROT    2
+#define FP_PROFILE_WADING_BOOTS  3
+#define FP_PROFILE_FLIGHT        4
+#define FP_PROFILE_TERMITE       5
+#define FP_PROFILE_PUMPKIN       6
+#define FP_PROFILE_WALRUS        7
+#define FP_PROFILE_CROC          8
+#define FP_PROFILE_BEE           9
+#define FP_PROFILE_WASHUP       10
+#define FP_PROFILE_SWIM_SURFACE 11
+#define FP_PROFILE_UNDERWATER   12
+
+typedef struct {
+    s32 active;          /* first person is on                          */
+    s32 profile;         /* FP_PROFILE_*                                */
+    u32 transformation;  /* player_getTransformation() at the update    */
+    u32 frame;           /* increments with every finalize              */
+    f32 eye[3];          /* eye position as drawn                       */
+    f32 rotation[3];     /* pitch, yaw, roll in degrees, as given to the viewport */
+    f32 fov;             /* vertical FOV in degrees                     */
+} FpCameraState;
+
+#ifndef FP_CAMERA_API_PROVIDER
+RECOMP_IMPORT("bk_first_person_mode", void fp_camera_get_state(FpCameraState *out));
+RECOMP_IMPORT("bk_first_person_mode", s32  fp_camera_is_active(void));
+#endif
+
+/* Events (subscribe with RECOMP_CALLBACK):
+ *   fp_on_enter(void)                            first person switched on
+ *   fp_on_exit(void)                             first person switched off,
+ *                                                including around map transitions
+ *   fp_on_camera_finalize(const FpCameraState *) final eye for this tick */
+
+#endif
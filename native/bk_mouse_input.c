@@ -2,7 +2,8 @@
  * bk_mouse_input.c — Mouse capture for BK first-person mode
  *
  * Native shared library loaded by BK:Recompiled at runtime.
- * Uses warp-to-center to compute mouse deltas each frame.
+ * Uses warp-to-center to compute mouse deltas each frame, or on Linux
+ * optionally confines the pointer and sums its motion events.
  *
  * All exported functions use the Recomp calling convention:
  *   void func(uint8_t* rdram, recomp_context* ctx)
@@ -19,6 +20,10 @@
  */
 
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 /* ------------------------------------------------------------------ */
 /* Platform export macro                                               */
@@ -69,6 +74,7 @@ typedef struct {
   #include <X11/cursorfont.h>
   #include <time.h>
   #include <pthread.h>
+  #include <poll.h>
   #include <unistd.h>
 #elif defined(_WIN32)
   #include <windows.h>
@@ -92,15 +98,23 @@ static int      delta_x, delta_y; /* last-frame mouse deltas            */
 static int      fp_wants_mouse;   /* MIPS sets this on FP enter/exit    */
 static int      esc_paused;       /* toggled by Escape key (menu open)  */
 static int      captured;         /* currently capturing? (composite)   */
+static int      ref_x, ref_y;     /* pointer position deltas are taken from */
+static int      confined;         /* last full poll read the confine sums */
 static int      cursor_hidden;    /* is cursor hidden via XFixes?       */
+static int      xr_pending;       /* requests queued since last flush   */
+static uint32_t xr_sent, xr_dropped, xr_flushes;
 static uint64_t last_poll_ms;     /* timestamp of last poll (ms)        */
 static pthread_t watchdog_thread;
 static volatile int watchdog_running;
+/* Held by the exported entry points and the watchdog around everything
+ * above and the request layer; taken before confine_lock, never after */
+static pthread_mutex_t mouse_lock = PTHREAD_MUTEX_INITIALIZER;
 #elif defined(_WIN32)
 static int      delta_x, delta_y; /* last-frame mouse deltas            */
 static int      fp_wants_mouse;   /* MIPS sets this on FP enter/exit    */
 static int      esc_paused;       /* toggled by Escape key (menu open)  */
 static int      captured;         /* currently capturing? (composite)   */
+static POINT    ref_pos;          /* cursor position deltas are taken from */
 static int      cursor_hidden;    /* have we called ShowCursor(FALSE)?  */
 static uint64_t last_poll_ms;     /* timestamp of last poll (ms)        */
 #endif
@@ -115,24 +129,33 @@ static uint64_t last_poll_ms;     /* timestamp of last poll (ms)        */
 #define WATCHDOG_INTERVAL_MS  100
 #define WATCHDOG_THRESHOLD_MS 200
 
+static void show_cursor(void);
+static void define_arrow(Window win);
+static void xr_flush(void);
+static void confine_stop(void);
+static void confine_shutdown(void);
+
 /* Watchdog: show cursor if mouse_poll hasn't been called recently.
- * Runs on a background thread; requires XInitThreads(). */
+ * Runs on a background thread; requires XInitThreads().  The main thread
+ * is stalled whenever this fires, so it does the work itself under
+ * mouse_lock rather than leaving it for the next poll. */
 static void *watchdog_func(void *arg) {
     (void)arg;
     while (watchdog_running) {
         usleep(WATCHDOG_INTERVAL_MS * 1000);
-        if (!dpy || !cursor_hidden || !fp_wants_mouse)
-            continue;
-        struct timespec ts;
-        clock_gettime(CLOCK_MONOTONIC, &ts);
-        uint64_t now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
-        if (last_poll_ms != 0 && (now - last_poll_ms) > WATCHDOG_THRESHOLD_MS) {
-            XFixesShowCursor(dpy, DefaultRootWindow(dpy));
-            if (cached_focus_win && arrow_cursor)
-                XDefineCursor(dpy, cached_focus_win, arrow_cursor);
-            XFlush(dpy);
-            cursor_hidden = 0;
+        pthread_mutex_lock(&mouse_lock);
+        if (dpy && cursor_hidden && fp_wants_mouse) {
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            uint64_t now = (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+            if (last_poll_ms != 0 && (now - last_poll_ms) > WATCHDOG_THRESHOLD_MS) {
+                confine_stop();
+                show_cursor();
+                define_arrow(cached_focus_win);
+                xr_flush();
+            }
         }
+        pthread_mutex_unlock(&mouse_lock);
     }
     return NULL;
 }
@@ -153,6 +176,7 @@ static void mouse_init(void) {
     esc_paused = 0;
     captured = 0;
     cursor_hidden = 0;
+    xr_pending = 0;
     last_poll_ms = 0;
 
     watchdog_running = 1;
@@ -166,10 +190,15 @@ static void mouse_shutdown(void) {
         pthread_join(watchdog_thread, NULL);
         watchdog_thread = 0;
     }
+    confine_shutdown();
 
     if (!dpy)
         return;
 
+    if (getenv("BK_MOUSE_STATS"))
+        fprintf(stderr, "bk_mouse_input: X requests sent %u, dropped %u, flushes %u\n",
+                xr_sent, xr_dropped, xr_flushes);
+
     if (cursor_hidden)
         XFixesShowCursor(dpy, DefaultRootWindow(dpy));
 
@@ -181,37 +210,339 @@ static void mouse_shutdown(void) {
 }
 
 /* ------------------------------------------------------------------ */
-/* Internal: cursor show/hide                                          */
+/* Internal: X request layer                                           */
+/*   Cursor visibility, the window cursor and warps go through here.   */
+/*   Visibility and warps compare against what the server already has  */
+/*   and drop the request if it would change nothing; the rest are only */
+/*   queued, and the exported entry points flush once on the way out.  */
+/*   Callers hold mouse_lock.                                          */
 /* ------------------------------------------------------------------ */
 
-static void hide_cursor(void) {
-    if (!cursor_hidden) {
-        XFixesHideCursor(dpy, DefaultRootWindow(dpy));
+static uint64_t get_time_ms_linux(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void xr_queued(void) {
+    xr_pending++;
+    xr_sent++;
+}
+
+/* Send everything queued since the last flush, if anything */
+static void xr_flush(void) {
+    if (xr_pending) {
         XFlush(dpy);
-        cursor_hidden = 1;
+        xr_pending = 0;
+        xr_flushes++;
     }
 }
 
-static void show_cursor(void) {
+static void hide_cursor(void) {
     if (cursor_hidden) {
-        XFixesShowCursor(dpy, DefaultRootWindow(dpy));
-        XFlush(dpy);
-        cursor_hidden = 0;
+        xr_dropped++;
+        return;
+    }
+    XFixesHideCursor(dpy, DefaultRootWindow(dpy));
+    xr_queued();
+    cursor_hidden = 1;
+}
+
+static void show_cursor(void) {
+    if (!cursor_hidden) {
+        xr_dropped++;
+        return;
+    }
+    XFixesShowCursor(dpy, DefaultRootWindow(dpy));
+    xr_queued();
+    cursor_hidden = 0;
+}
+
+/* Give win the arrow cursor (overrides SDL's blank cursor).  Never
+ * dropped: SDL sets its cursor on its own connection and we cannot see
+ * when, so every call re-asserts the arrow. */
+static void define_arrow(Window win) {
+    if (win == None || !arrow_cursor)
+        return;
+    XDefineCursor(dpy, win, arrow_cursor);
+    xr_queued();
+}
+
+/* Move the pointer to (x, y) in win; (at_x, at_y) is where it is now */
+static void warp_pointer(Window win, int x, int y, int at_x, int at_y) {
+    if (at_x == x && at_y == y) {
+        xr_dropped++;
+        return;
+    }
+    XWarpPointer(dpy, None, win, 0, 0, 0, 0, x, y);
+    xr_queued();
+}
+
+/* ------------------------------------------------------------------ */
+/* Internal: confined capture                                          */
+/*   Warp-to-center only sees where the pointer ended up each poll, so  */
+/*   motion past the window edge between two polls is lost. Confine     */
+/*   mode keeps the pointer inside the window with XFixes pointer       */
+/*   barriers (servers without them get warp capture), and a thread     */
+/*   on its own connection adds up every MotionNotify. The thread       */
+/*   re-centres the pointer as soon as it nears an edge, so a flick     */
+/*   arrives whole in any frame shorter than the watchdog threshold.    */
+/* ------------------------------------------------------------------ */
+
+#define CAPTURE_WARP      0
+#define CAPTURE_CONFINE   1
+#define CONFINE_WAKE_MS  50     /* capture thread checks for shutdown  */
+
+/* confine_warp_pending: a warp to the centre has been sent and its
+ * MotionNotify not seen yet.  That event is the first one carrying the
+ * warp's request serial or later, and it is at the centre; events with
+ * an earlier serial are real motion queued before the warp, wherever
+ * they are.  A warp that found the pointer already at the centre sends
+ * no event, so the first later one elsewhere is real motion. */
+#define WARP_NONE         0
+#define WARP_RECENTRE     1     /* motion before it still counts       */
+#define WARP_START        2     /* capture start: ignore what's before */
+
+static int       capture_mode;       /* CAPTURE_*, set by the mod        */
+static Display  *confine_dpy;        /* capture thread's connection      */
+static int       confine_barriers;   /* server has XFixes 5 barriers?    */
+static int       confine_failed;     /* no connection; fall back to warp */
+static pthread_t confine_thread;
+static volatile int confine_running;
+static pthread_mutex_t confine_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Guarded by confine_lock */
+static Window    confine_win;        /* None when not confining          */
+static unsigned long confine_serial; /* events older than this start are stale */
+static PointerBarrier confine_bar[4];
+static int       confine_x0, confine_y0, confine_x1, confine_y1; /* root coords */
+static int       confine_margin;     /* re-centre this close to an edge  */
+static int       confine_last_x, confine_last_y;
+static int       confine_warp_pending;
+static unsigned long confine_warp_serial; /* request serial of that warp */
+static int       confine_acc_x, confine_acc_y;
+static int       confine_moved;      /* window moved or resized          */
+
+static int confine_center_x(void) { return (confine_x0 + confine_x1) / 2; }
+static int confine_center_y(void) { return (confine_y0 + confine_y1) / 2; }
+
+/* Warp the pointer to the window centre and remember which request did.
+ * Called with confine_lock held. */
+static void confine_warp(int pending) {
+    confine_warp_serial = NextRequest(confine_dpy);
+    XWarpPointer(confine_dpy, None, DefaultRootWindow(confine_dpy),
+                 0, 0, 0, 0, confine_center_x(), confine_center_y());
+    confine_warp_pending = pending;
+}
+
+/* One MotionNotify, in root coordinates.  Called with confine_lock held.
+ * Only pointer positions are summed, so a single device report that
+ * carries the pointer past the barrier is clipped there. */
+static void confine_motion(int x, int y, unsigned long serial) {
+    if (confine_warp_pending != WARP_NONE && serial >= confine_warp_serial) {
+        confine_warp_pending = WARP_NONE;
+        if (x == confine_center_x() && y == confine_center_y()) {
+            /* The warp's own event: motion queued before it was already counted */
+            confine_last_x = x;
+            confine_last_y = y;
+            return;
+        }
+    }
+    if (confine_warp_pending != WARP_START) {
+        confine_acc_x += x - confine_last_x;
+        confine_acc_y += y - confine_last_y;
+    }
+    confine_last_x = x;
+    confine_last_y = y;
+
+    if (confine_warp_pending == WARP_NONE
+        && (x < confine_x0 + confine_margin || x > confine_x1 - confine_margin
+         || y < confine_y0 + confine_margin || y > confine_y1 - confine_margin)) {
+        confine_warp(WARP_RECENTRE);
+        XFlush(confine_dpy);
+    }
+}
+
+static void *confine_thread_func(void *arg) {
+    struct pollfd pfd;
+    XEvent ev;
+
+    (void)arg;
+    pfd.fd = ConnectionNumber(confine_dpy);
+    pfd.events = POLLIN;
+    while (confine_running) {
+        if (!XPending(confine_dpy)) {
+            poll(&pfd, 1, CONFINE_WAKE_MS);
+            continue;
+        }
+        XNextEvent(confine_dpy, &ev);
+        pthread_mutex_lock(&confine_lock);
+        if (confine_win != None && ev.xany.serial >= confine_serial) {
+            if (ev.type == MotionNotify)
+                confine_motion(ev.xmotion.x_root, ev.xmotion.y_root, ev.xany.serial);
+            else if (ev.type == ConfigureNotify)
+                confine_moved = 1;
+        }
+        pthread_mutex_unlock(&confine_lock);
+    }
+    return NULL;
+}
+
+/* Open the capture connection on first use.  Returns 0 if unavailable. */
+static int confine_open(void) {
+    int major = 0, minor = 0;
+
+    if (confine_dpy)
+        return 1;
+    if (confine_failed)
+        return 0;
+    confine_dpy = XOpenDisplay(NULL);
+    if (!confine_dpy) {
+        confine_failed = 1;
+        return 0;
+    }
+    confine_barriers = XFixesQueryVersion(confine_dpy, &major, &minor) && major >= 5;
+    confine_running = 1;
+    if (pthread_create(&confine_thread, NULL, confine_thread_func, NULL) != 0) {
+        confine_running = 0;
+        XCloseDisplay(confine_dpy);
+        confine_dpy = NULL;
+        confine_failed = 1;
+        return 0;
+    }
+    return 1;
+}
+
+/* Release the pointer.  Safe to call when not confining.  Motion already
+ * added up is kept, so a frame long enough to trip the watchdog still
+ * delivers what happened before it. */
+static void confine_stop(void) {
+    int i;
+
+    if (!confine_dpy)
+        return;
+    pthread_mutex_lock(&confine_lock);
+    if (confine_win != None) {
+        for (i = 0; i < 4; i++)
+            XFixesDestroyPointerBarrier(confine_dpy, confine_bar[i]);
+        XSelectInput(confine_dpy, confine_win, NoEventMask);
+        XFlush(confine_dpy);
+        confine_win = None;
     }
+    pthread_mutex_unlock(&confine_lock);
 }
 
-/* Force-show cursor with a real arrow image (overrides SDL's blank cursor).
- * Called from MIPS hooks every frame during pause menus. */
+/* Confine the pointer to win, (re)building the barriers if the window
+ * changed or moved.  (at_x, at_y) is where the pointer is now, relative
+ * to win; if it is off centre it is warped there, and motion before that
+ * is ignored.  Returns 0 if confinement is not possible.  There is no
+ * grab fallback: an active grab takes every pointer event, buttons
+ * included, away from the game's connection whatever its mask. */
+static int confine_start(Window win, const XWindowAttributes *attr, int at_x, int at_y) {
+    Window root = DefaultRootWindow(dpy), child;
+    int rx, ry;
+
+    if (!confine_open() || !confine_barriers)
+        return 0;
+    pthread_mutex_lock(&confine_lock);
+    if (confine_win == win && !confine_moved
+        && confine_x1 - confine_x0 + 1 == attr->width
+        && confine_y1 - confine_y0 + 1 == attr->height) {
+        pthread_mutex_unlock(&confine_lock);
+        return 1;
+    }
+    pthread_mutex_unlock(&confine_lock);
+    confine_stop();
+
+    if (attr->width < 8 || attr->height < 8
+        || !XTranslateCoordinates(dpy, win, root, 0, 0, &rx, &ry, &child))
+        return 0;
+
+    pthread_mutex_lock(&confine_lock);
+    confine_x0 = rx;
+    confine_y0 = ry;
+    confine_x1 = rx + attr->width - 1;
+    confine_y1 = ry + attr->height - 1;
+    confine_margin = (attr->width < attr->height ? attr->width : attr->height) / 4;
+    confine_moved = 0;
+    confine_serial = NextRequest(confine_dpy);
+    confine_last_x = rx + at_x;
+    confine_last_y = ry + at_y;
+    confine_warp_pending = WARP_NONE;
+
+    /* Each barrier only lets the pointer move back into the window */
+    confine_bar[0] = XFixesCreatePointerBarrier(confine_dpy, root,
+        rx, ry, rx, confine_y1 + 1, BarrierPositiveX, 0, NULL);
+    confine_bar[1] = XFixesCreatePointerBarrier(confine_dpy, root,
+        confine_x1 + 1, ry, confine_x1 + 1, confine_y1 + 1, BarrierNegativeX, 0, NULL);
+    confine_bar[2] = XFixesCreatePointerBarrier(confine_dpy, root,
+        rx, ry, confine_x1 + 1, ry, BarrierPositiveY, 0, NULL);
+    confine_bar[3] = XFixesCreatePointerBarrier(confine_dpy, root,
+        rx, confine_y1 + 1, confine_x1 + 1, confine_y1 + 1, BarrierNegativeY, 0, NULL);
+    /* Motion only: button and key events stay with the game */
+    XSelectInput(confine_dpy, win, PointerMotionMask | StructureNotifyMask);
+    if (confine_last_x != confine_center_x() || confine_last_y != confine_center_y())
+        confine_warp(WARP_START);
+    confine_win = win;
+    XFlush(confine_dpy);
+    pthread_mutex_unlock(&confine_lock);
+    return 1;
+}
+
+/* Motion added up by the capture thread since the last call */
+static void confine_take(int *dx, int *dy) {
+    pthread_mutex_lock(&confine_lock);
+    *dx = confine_acc_x;
+    *dy = confine_acc_y;
+    confine_acc_x = 0;
+    confine_acc_y = 0;
+    pthread_mutex_unlock(&confine_lock);
+}
+
+/* Forget motion that was not taken before capture ended */
+static void confine_discard(void) {
+    int dx, dy;
+    confine_take(&dx, &dy);
+}
+
+static void confine_shutdown(void) {
+    if (!confine_dpy)
+        return;
+    confine_stop();
+    confine_running = 0;
+    pthread_join(confine_thread, NULL);
+    XCloseDisplay(confine_dpy);
+    confine_dpy = NULL;
+}
+
+static void release_capture(void) {
+    fp_wants_mouse = 0;
+    captured = 0;
+    esc_paused = 0;
+    delta_x = 0;
+    delta_y = 0;
+    confine_stop();
+    confine_discard();
+    if (dpy)
+        show_cursor();
+}
+
+/* Capture is lost for this poll (no focus, menu open, query failed) */
+static void drop_capture(void) {
+    captured = 0;
+    confine_stop();
+    confine_discard();
+    show_cursor();
+}
+
+/* Release capture and show a real arrow image.  Called from the pause
+ * menu draw hook once per frame; after the first frame that is one
+ * XDefineCursor and one flush. */
 static void do_mouse_force_show_cursor(void) {
+    release_capture();
     if (!dpy)
         return;
-    if (cursor_hidden) {
-        XFixesShowCursor(dpy, DefaultRootWindow(dpy));
-        cursor_hidden = 0;
-    }
-    if (cached_focus_win && arrow_cursor)
-        XDefineCursor(dpy, cached_focus_win, arrow_cursor);
-    XFlush(dpy);
+    define_arrow(cached_focus_win);
 }
 
 /* ------------------------------------------------------------------ */
@@ -224,12 +555,6 @@ static void do_mouse_force_show_cursor(void) {
 
 static int esc_was_down;
 
-static uint64_t get_time_ms_linux(void) {
-    struct timespec ts;
-    clock_gettime(CLOCK_MONOTONIC, &ts);
-    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
-}
-
 /* ------------------------------------------------------------------ */
 /* Internal poll logic (called by the exported wrapper)                 */
 /* ------------------------------------------------------------------ */
@@ -278,22 +603,19 @@ static void do_mouse_poll(void) {
     /* Get focused window */
     XGetInputFocus(dpy, &focus_win, &revert);
     if (focus_win == None || focus_win == PointerRoot) {
-        captured = 0;
-        show_cursor();
+        drop_capture();
         return;
     }
     cached_focus_win = focus_win;
 
     if (!should_capture) {
-        captured = 0;
-        show_cursor();
+        drop_capture();
         return;
     }
 
     /* Get window geometry for center computation */
     if (!XGetWindowAttributes(dpy, focus_win, &attr)) {
-        captured = 0;
-        show_cursor();
+        drop_capture();
         return;
     }
 
@@ -303,35 +625,82 @@ static void do_mouse_poll(void) {
     /* Query current pointer position relative to the focused window */
     if (!XQueryPointer(dpy, focus_win, &root_ret, &child_ret,
                        &root_x, &root_y, &win_x, &win_y, &mask)) {
-        captured = 0;
-        show_cursor();
+        drop_capture();
         return;
     }
 
-    /* Compute deltas from center */
-    delta_x = win_x - cx;
-    delta_y = win_y - cy;
+    /* Confine mode: the capture thread has been adding up the motion */
+    if (capture_mode == CAPTURE_CONFINE && confine_start(focus_win, &attr, win_x, win_y)) {
+        confine_take(&delta_x, &delta_y);
+        ref_x = win_x;
+        ref_y = win_y;
+        hide_cursor();
+        captured = 1;
+        confined = 1;
+        return;
+    }
+    confine_stop();
+    confined = 0;
+
+    /* Compute deltas from center (or from where the latch poll left it) */
+    if (!captured) {
+        ref_x = cx;
+        ref_y = cy;
+    }
+    delta_x = win_x - ref_x;
+    delta_y = win_y - ref_y;
 
     /* Warp pointer back to center */
-    XWarpPointer(dpy, None, focus_win, 0, 0, 0, 0, cx, cy);
+    warp_pointer(focus_win, cx, cy, win_x, win_y);
+    ref_x = cx;
+    ref_y = cy;
 
     /* Hide cursor while captured */
     hide_cursor();
 
-    XFlush(dpy);
     captured = 1;
 }
 
-static void do_mouse_set_enabled(int enabled) {
-    fp_wants_mouse = enabled;
-    if (!enabled) {
-        captured = 0;
-        esc_paused = 0;
-        delta_x = 0;
-        delta_y = 0;
-        if (dpy)
-            show_cursor();
+/* Second, cheaper poll in the same frame (render-time late latch):
+ * keeps the focus, menu and capture decisions of the frame's full poll
+ * and only reads the motion since then.  One round trip, and no warp;
+ * the next full poll re-centres.  Nothing is queued here, so a captured
+ * frame's only flush is the one mouse_poll makes. */
+static void do_mouse_poll_latch(void) {
+    Window root_ret, child_ret;
+    int root_x, root_y, win_x, win_y;
+    unsigned int mask;
+
+    delta_x = 0;
+    delta_y = 0;
+    if (!dpy || !captured)
+        return;
+
+    if (confined) {
+        confine_take(&delta_x, &delta_y);
+        return;
     }
+    if (!XQueryPointer(dpy, cached_focus_win, &root_ret, &child_ret,
+                       &root_x, &root_y, &win_x, &win_y, &mask))
+        return;
+    delta_x = win_x - ref_x;
+    delta_y = win_y - ref_y;
+    ref_x = win_x;
+    ref_y = win_y;
+}
+
+static void do_mouse_set_capture_mode(int mode) {
+    if (mode == capture_mode)
+        return;
+    confine_stop();
+    capture_mode = mode;
+}
+
+static void do_mouse_set_enabled(int enabled) {
+    if (enabled)
+        fp_wants_mouse = 1;
+    else
+        release_capture();
 }
 
 #endif /* __linux__ */
@@ -456,12 +825,15 @@ static void do_mouse_poll_win32(void) {
         return;
     }
 
-    /* Compute deltas from center */
-    delta_x = cursor.x - center.x;
-    delta_y = cursor.y - center.y;
+    /* Compute deltas from center (or from where the latch poll left it) */
+    if (!captured)
+        ref_pos = center;
+    delta_x = cursor.x - ref_pos.x;
+    delta_y = cursor.y - ref_pos.y;
 
     /* Warp cursor back to center */
     SetCursorPos(center.x, center.y);
+    ref_pos = center;
 
     /* Hide cursor while captured */
     hide_cursor_win32();
@@ -469,6 +841,20 @@ static void do_mouse_poll_win32(void) {
     captured = 1;
 }
 
+/* Second poll in the same frame (render-time late latch): motion since
+ * the frame's full poll, without re-centring */
+static void do_mouse_poll_latch_win32(void) {
+    POINT cursor;
+
+    delta_x = 0;
+    delta_y = 0;
+    if (!captured || !GetCursorPos(&cursor))
+        return;
+    delta_x = cursor.x - ref_pos.x;
+    delta_y = cursor.y - ref_pos.y;
+    ref_pos = cursor;
+}
+
 static void do_mouse_set_enabled_win32(int enabled) {
     fp_wants_mouse = enabled;
     if (!enabled) {
@@ -480,8 +866,159 @@ static void do_mouse_set_enabled_win32(int enabled) {
     }
 }
 
+static void do_mouse_force_show_cursor_win32(void) {
+    do_mouse_set_enabled_win32(0);
+}
+
 #endif /* _WIN32 */
 
+/* ------------------------------------------------------------------ */
+/* Monotonic clock (replay timing, FP_PROFILER builds of the mod)      */
+/*   osGetCount() only ticks at the emulated N64 rate, far too coarse   */
+/*   for the sub-microsecond stages of the camera update.               */
+/* ------------------------------------------------------------------ */
+
+static uint64_t clock_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER c;
+    if (!freq.QuadPart)
+        QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&c);
+    return (uint64_t)(c.QuadPart / freq.QuadPart) * 1000000000ULL
+         + (uint64_t)(c.QuadPart % freq.QuadPart) * 1000000000ULL / (uint64_t)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Truncated to 32 bits: callers only subtract */
+static uint32_t prof_now_ns(void) {
+    return (uint32_t)clock_now_ns();
+}
+
+/* ------------------------------------------------------------------ */
+/* Replay input (testing)                                              */
+/*   BK_MOUSE_REPLAY=<file> replaces the OS pointer with "dx dy" pairs. */
+/*   Pairs become due at a fixed real-time rate, BK_MOUSE_REPLAY_HZ     */
+/*   (default 60, one per frame at 60 fps; use the mouse's report rate  */
+/*   for a sensor trace), and each poll returns every pair that fell    */
+/*   due since the previous one. Extra polls in a frame (the late       */
+/*   latch) therefore pick motion up sooner but never replay it faster. */
+/*   Deltas read as 0 once the file runs out. With BK_MOUSE_STATS set, */
+/*   the average age of the motion when a poll delivered it is printed  */
+/*   at exit.                                                           */
+/* ------------------------------------------------------------------ */
+
+#if defined(__linux__) || defined(_WIN32)
+
+#define REPLAY_HZ_DEFAULT 60.0
+
+static FILE    *replay_file;
+static int      replay_checked;
+static double   replay_ns_per_pair;
+static int      replay_running;   /* capture on; the schedule is live    */
+static uint64_t replay_start_ns;  /* when pair 0 fell due                */
+static uint64_t replay_pairs;     /* pairs consumed                      */
+static double   replay_age_ns;    /* sum of |motion| * age when delivered */
+static double   replay_motion;    /* sum of |motion|                     */
+
+/* Returns 1 if the poll was served from the replay file */
+static int replay_poll(void) {
+    uint64_t now;
+    int dx, dy;
+
+    if (!replay_checked) {
+        const char *path = getenv("BK_MOUSE_REPLAY");
+        const char *hz = getenv("BK_MOUSE_REPLAY_HZ");
+        double rate = hz ? atof(hz) : 0.0;
+        replay_checked = 1;
+        if (path && path[0])
+            replay_file = fopen(path, "r");
+        replay_ns_per_pair = 1e9 / (rate > 0.0 ? rate : REPLAY_HZ_DEFAULT);
+    }
+    if (!replay_file)
+        return 0;
+
+    delta_x = 0;
+    delta_y = 0;
+    captured = fp_wants_mouse;
+    if (!fp_wants_mouse) {
+        replay_running = 0;
+        return 1;
+    }
+
+    /* Resume so the next pair is due now; time spent released is skipped */
+    now = clock_now_ns();
+    if (!replay_running) {
+        replay_start_ns = now - (uint64_t)(replay_pairs * replay_ns_per_pair);
+        replay_running = 1;
+    }
+
+    while (replay_start_ns + (uint64_t)(replay_pairs * replay_ns_per_pair) <= now) {
+        double due = replay_start_ns + replay_pairs * replay_ns_per_pair;
+        double size;
+        if (fscanf(replay_file, "%d %d", &dx, &dy) != 2)
+            break;
+        size = abs(dx) + abs(dy);
+        replay_age_ns += size * ((double)now - due);
+        replay_motion += size;
+        delta_x += dx;
+        delta_y += dy;
+        replay_pairs++;
+    }
+    return 1;
+}
+
+__attribute__((destructor))
+static void replay_shutdown(void) {
+    if (!replay_file)
+        return;
+    if (getenv("BK_MOUSE_STATS") && replay_motion > 0.0)
+        fprintf(stderr, "bk_mouse_input: replay pairs %llu, motion age at delivery %.2f ms\n",
+                (unsigned long long)replay_pairs, replay_age_ns / replay_motion / 1e6);
+    fclose(replay_file);
+    replay_file = NULL;
+}
+
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Files in the mod folder                                             */
+/*   The mod has no file I/O, so it hands us its mod folder path and a  */
+/*   buffer of 32-bit words. The calibration cache stores the words in  */
+/*   host byte order: it is only read back on the machine that wrote it.*/
+/* ------------------------------------------------------------------ */
+
+#define CALIB_FILE_NAME  "fp_calibration.bin"
+#define PROF_FILE_NAME   "fp_profile.txt"
+#define CALIB_PATH_MAX   1024
+
+/* Guest pointers arrive sign-extended; RDRAM stores 32-bit words in host
+ * order, so single bytes sit at address ^ 3 */
+#define RDRAM_W(rdram, addr) (*(uint32_t *)((rdram) + ((addr) - 0xFFFFFFFF80000000ULL)))
+#define RDRAM_B(rdram, addr) (*(char *)((rdram) + (((addr) ^ 3) - 0xFFFFFFFF80000000ULL)))
+
+/* Returns 0 if the folder path does not fit */
+static int mod_file_path(uint8_t *rdram, gpr folder, const char *name, char *out) {
+    size_t len = strlen(name), n = 0;
+
+    while (n < CALIB_PATH_MAX - len - 2) {
+        char c = RDRAM_B(rdram, folder + n);
+        if (c == '\0')
+            break;
+        out[n++] = c;
+    }
+    if (n >= CALIB_PATH_MAX - len - 2)
+        return 0;
+    if (n > 0 && out[n - 1] != '/' && out[n - 1] != '\\')
+        out[n++] = '/';
+    memcpy(out + n, name, len + 1);
+    return 1;
+}
+
 /* ------------------------------------------------------------------ */
 /* Exported API — Recomp calling convention                            */
 /*   void func(uint8_t* rdram, recomp_context* ctx)                    */
@@ -491,13 +1028,37 @@ static void do_mouse_set_enabled_win32(int enabled) {
 
 EXPORT void mouse_poll(uint8_t* rdram, recomp_context* ctx) {
     (void)rdram; (void)ctx;
+#if defined(__linux__) || defined(_WIN32)
+    if (replay_poll())
+        return;
+#endif
 #if defined(__linux__)
+    pthread_mutex_lock(&mouse_lock);
     do_mouse_poll();
+    if (dpy)
+        xr_flush();
+    pthread_mutex_unlock(&mouse_lock);
 #elif defined(_WIN32)
     do_mouse_poll_win32();
 #endif
 }
 
+/* Render-time re-poll: motion since the frame's mouse_poll */
+EXPORT void mouse_poll_latch(uint8_t* rdram, recomp_context* ctx) {
+    (void)rdram; (void)ctx;
+#if defined(__linux__) || defined(_WIN32)
+    if (replay_poll())
+        return;
+#endif
+#if defined(__linux__)
+    pthread_mutex_lock(&mouse_lock);
+    do_mouse_poll_latch();
+    pthread_mutex_unlock(&mouse_lock);
+#elif defined(_WIN32)
+    do_mouse_poll_latch_win32();
+#endif
+}
+
 EXPORT void mouse_get_delta_x(uint8_t* rdram, recomp_context* ctx) {
     (void)rdram;
 #if defined(__linux__) || defined(_WIN32)
@@ -519,7 +1080,11 @@ EXPORT void mouse_get_delta_y(uint8_t* rdram, recomp_context* ctx) {
 EXPORT void mouse_set_enabled(uint8_t* rdram, recomp_context* ctx) {
     (void)rdram;
 #if defined(__linux__)
+    pthread_mutex_lock(&mouse_lock);
     do_mouse_set_enabled((int)ctx->r4);
+    if (dpy)
+        xr_flush();
+    pthread_mutex_unlock(&mouse_lock);
 #elif defined(_WIN32)
     do_mouse_set_enabled_win32((int)ctx->r4);
 #else
@@ -527,6 +1092,21 @@ EXPORT void mouse_set_enabled(uint8_t* rdram, recomp_context* ctx) {
 #endif
 }
 
+/* mouse_set_capture_mode(int mode): 0 = warp to center, 1 = confine.
+ * Confine is Linux only; Windows always warps. */
+EXPORT void mouse_set_capture_mode(uint8_t* rdram, recomp_context* ctx) {
+    (void)rdram;
+#if defined(__linux__)
+    pthread_mutex_lock(&mouse_lock);
+    do_mouse_set_capture_mode((int)ctx->r4);
+    if (dpy)
+        xr_flush();
+    pthread_mutex_unlock(&mouse_lock);
+#else
+    (void)ctx;
+#endif
+}
+
 EXPORT void mouse_is_enabled(uint8_t* rdram, recomp_context* ctx) {
     (void)rdram;
 #if defined(__linux__) || defined(_WIN32)
@@ -545,13 +1125,113 @@ EXPORT void mouse_is_captured(uint8_t* rdram, recomp_context* ctx) {
 #endif
 }
 
-/* Force-show the cursor with a visible arrow image.
- * Called from MIPS pause menu hooks every frame to override SDL's blank cursor. */
+/* Release the mouse and force-show the cursor with a visible arrow image.
+ * Called from the MIPS pause menu draw hook every frame to override SDL's
+ * blank cursor; stands in for mouse_set_enabled(0), so a pause frame
+ * costs one flush. */
 EXPORT void mouse_force_show_cursor(uint8_t* rdram, recomp_context* ctx) {
     (void)rdram; (void)ctx;
 #if defined(__linux__)
+    pthread_mutex_lock(&mouse_lock);
     do_mouse_force_show_cursor();
+    if (dpy)
+        xr_flush();
+    pthread_mutex_unlock(&mouse_lock);
 #elif defined(_WIN32)
-    show_cursor_win32();
+    do_mouse_force_show_cursor_win32();
 #endif
 }
+
+/* calib_file_read(const char *folder, u32 *words, u32 max_words)
+ * Returns the number of words read, 0 if there is no cache file. */
+EXPORT void calib_file_read(uint8_t* rdram, recomp_context* ctx) {
+    char path[CALIB_PATH_MAX];
+    FILE *f;
+    uint32_t i, n = 0, max = (uint32_t)ctx->r6;
+
+    ctx->r2 = 0;
+    if (!mod_file_path(rdram, ctx->r4, CALIB_FILE_NAME, path))
+        return;
+    f = fopen(path, "rb");
+    if (!f)
+        return;
+    for (i = 0; i < max; i++) {
+        uint32_t w;
+        if (fread(&w, sizeof(w), 1, f) != 1)
+            break;
+        RDRAM_W(rdram, ctx->r5 + i * 4) = w;
+        n++;
+    }
+    fclose(f);
+    ctx->r2 = n;
+}
+
+/* calib_file_write(const char *folder, const u32 *words, u32 count)
+ * Returns 1 if the whole buffer was written. */
+EXPORT void calib_file_write(uint8_t* rdram, recomp_context* ctx) {
+    char path[CALIB_PATH_MAX];
+    FILE *f;
+    uint32_t i, count = (uint32_t)ctx->r6;
+    int ok = 1;
+
+    ctx->r2 = 0;
+    if (!mod_file_path(rdram, ctx->r4, CALIB_FILE_NAME, path))
+        return;
+    f = fopen(path, "wb");
+    if (!f)
+        return;
+    for (i = 0; i < count && ok; i++) {
+        uint32_t w = RDRAM_W(rdram, ctx->r5 + i * 4);
+        ok = fwrite(&w, sizeof(w), 1, f) == 1;
+    }
+    if (fclose(f) != 0)
+        ok = 0;
+    ctx->r2 = ok;
+}
+
+/* prof_clock_ns(void) -> u32 nanoseconds */
+EXPORT void prof_clock_ns(uint8_t* rdram, recomp_context* ctx) {
+    (void)rdram;
+    ctx->r2 = (int32_t)prof_now_ns();
+}
+
+/* prof_write_report(const char *folder, const u32 *words, u32 stages,
+ *                   const char *names)
+ * words holds { samples, p50_ns, p99_ns, max_ns } per stage; names is the
+ * stage names separated by '\n'. Appends one session to fp_profile.txt. */
+EXPORT void prof_write_report(uint8_t* rdram, recomp_context* ctx) {
+    char path[CALIB_PATH_MAX], name[32];
+    FILE *f;
+    uint32_t i, stages = (uint32_t)ctx->r6;
+    gpr names = ctx->r7;
+    time_t now = time(NULL);
+
+    ctx->r2 = 0;
+    if (!mod_file_path(rdram, ctx->r4, PROF_FILE_NAME, path))
+        return;
+    f = fopen(path, "a");
+    if (!f)
+        return;
+    fprintf(f, "--- first person session, %s", ctime(&now));
+    fprintf(f, "%-12s %8s %9s %9s %9s\n", "stage", "samples", "p50 us", "p99 us", "max us");
+    for (i = 0; i < stages; i++) {
+        gpr w = ctx->r5 + i * 16;
+        size_t n = 0;
+        char c;
+
+        while ((c = RDRAM_B(rdram, names)) != '\0') {
+            names++;
+            if (c == '\n')
+                break;
+            if (n < sizeof(name) - 1)
+                name[n++] = c;
+        }
+        name[n] = '\0';
+        fprintf(f, "%-12s %8u %9.2f %9.2f %9.2f\n", name,
+                RDRAM_W(rdram, w),
+                RDRAM_W(rdram, w + 4) / 1000.0,
+                RDRAM_W(rdram, w + 8) / 1000.0,
+                RDRAM_W(rdram, w + 12) / 1000.0);
+    }
+    ctx->r2 = fclose(f) == 0;
+}
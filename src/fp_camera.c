@@ -3,6 +3,9 @@
 #include "recompconfig.h"
 #include "PR/ultratypes.h"
 
+#define FP_CAMERA_API_PROVIDER
+#include "fp_camera_api.h"
+
 /* ------------------------------------------------------------------ */
 /* Base game function declarations (resolved via syms.toml)            */
 /* ------------------------------------------------------------------ */
@@ -25,6 +28,7 @@ f32  mlNormalizeAngle(f32 angle);
 void viewport_setPosition_vec3f(f32 src[3]);
 void viewport_setRotation_vec3f(f32 src[3]);
 void viewport_getRotation_vec3f(f32 dst[3]);
+void viewport_getPosition_vec3f(f32 dst[3]);
 void baModel_802924E8(f32 dst[3]);
 void baModel_80291A50(s32 bone_index, f32 dst[3]);
 f32  gu_sqrtf(f32 x);
@@ -32,19 +36,32 @@ f32  ml_sin_deg(f32 deg);
 f32  ml_cos_deg(f32 deg);
 f32  viewport_getFOVy(void);
 void viewport_setFOVy(f32 fovy);
+void viewport_setNearAndFar(f32 near, f32 far);
+void viewport_getNearAndFar(f32 *near, f32 *far);
 int  gcpausemenu_80314B00(void);  /* returns 0 when pause menu is open */
+u32  osGetCount(void);             /* CPU count register, OS_CPU_COUNTER Hz */
+/* Line vs. level collision: on a hit, moves `end` to the hit point,
+ * writes the surface normal and returns the triangle (NULL if clear) */
+void *func_80309B48(f32 start[3], f32 end[3], f32 normal[3], s32 flags);
 
 /* ------------------------------------------------------------------ */
 /* Native mouse input library (imported from own mod's native .so)     */
 /* ------------------------------------------------------------------ */
 
 RECOMP_IMPORT(".", void mouse_poll(void));
+RECOMP_IMPORT(".", void mouse_poll_latch(void));
 RECOMP_IMPORT(".", int  mouse_get_delta_x(void));
 RECOMP_IMPORT(".", int  mouse_get_delta_y(void));
 RECOMP_IMPORT(".", void mouse_set_enabled(int enabled));
 RECOMP_IMPORT(".", int  mouse_is_enabled(void));
 RECOMP_IMPORT(".", int  mouse_is_captured(void));
 RECOMP_IMPORT(".", void mouse_force_show_cursor(void));
+RECOMP_IMPORT(".", void mouse_set_capture_mode(int mode));
+RECOMP_IMPORT(".", u32  calib_file_read(const unsigned char *folder, u32 *words, u32 max_words));
+RECOMP_IMPORT(".", s32  calib_file_write(const unsigned char *folder, const u32 *words, u32 count));
+RECOMP_IMPORT(".", u32  prof_clock_ns(void));
+RECOMP_IMPORT(".", s32  prof_write_report(const unsigned char *folder, const u32 *words, u32 stages,
+                                          const char *names));
 
 /* Player model rotation (degrees, used by renderer — captures full rolls/flips) */
 f32  pitch_get(void);
@@ -110,36 +127,71 @@ s32  bastick_getZone(void);
 #define TRANSFORM_BEE      6
 #define TRANSFORM_WASHUP   7
 #define FP_BOB_SMOOTH     6.0f   /* Y-smoothing speed (higher = less damping) */
+#define FP_UNDERWATER_SPRING 3.0f  /* underwater look spring-back (rad/sec, critically damped) */
 #define FP_GEO_PITCH_MAX   5.0f  /* max geometric pitch in degrees (limits run/jump lean) */
 #define FP_GEO_ROLL_MAX   10.0f  /* max geometric roll in degrees (limits walk tilt)      */
 
-/* Synthetic head bob for transformations without bone data */
-#define FP_SYNTH_BOB_PUMPKIN_IDLE  310.0f   /* deg/sec  (idle hop, slightly faster)            */
-#define FP_SYNTH_BOB_PUMPKIN_WALK 2466.0f   /* deg/sec  (50 cycles / 7.3 sec × 360)           */
-#define FP_SYNTH_BOB_PUMPKIN_AMP     1.5f   /* Y units — small for rapid walk cycle            */
-#define FP_SYNTH_BOB_PUMPKIN_IDLE_AMP 3.0f  /* Y units — larger for slow idle hop              */
-#define FP_BEE_WALK_FREQ          720.0f   /* deg/sec  (10 cycles / 5 sec × 360)              */
-#define FP_BEE_WALK_ROLL            3.0f   /* degrees of roll rotation (body dip)             */
-
-/* Termite sway: side-to-side with downward dip at extremes */
-#define FP_TERMITE_SWAY_FREQ     300.0f   /* deg/sec  (10 cycles / 12 sec × 360)             */
-#define FP_TERMITE_SWAY_HORIZ      3.0f   /* horizontal sway amplitude (perpendicular to yaw) */
-#define FP_TERMITE_SWAY_DIP        2.0f   /* vertical dip amplitude at extremes               */
-
-/* Talon trot bob */
-#define FP_TROT_BOB_FREQ          360.0f   /* deg/sec  (50 bobs / 50 sec × 360)              */
-#define FP_TROT_BOB_AMP             2.0f   /* Y units                                         */
-
-/* Washing machine sway amplitudes */
-#define FP_WASHUP_WALK_FREQ      720.0f   /* deg/sec  (20 cycles / 10 sec × 360)             */
-#define FP_WASHUP_SWAY_HORIZ     10.0f   /* horizontal sway amplitude (walk + idle)          */
-#define FP_WASHUP_SWAY_VERT       7.0f   /* vertical arc amplitude (walk)                    */
-#define FP_WASHUP_IDLE_SWAY        5.0f   /* idle harmonic sway amplitude                     */
-
-/* Bee idle sway: asymmetric harmonic — sin(p) + 0.35*sin(3p) */
-#define FP_BEE_IDLE_FREQ         120.0f   /* deg/sec  (10 cycles / 30 sec × 360)             */
-#define FP_BEE_IDLE_SWAY           3.0f   /* horizontal sway amplitude                       */
-#define FP_BEE_IDLE_HARMONIC       0.35f  /* 3rd harmonic weight (creates double-left bounce) */
+/* Camera update timing */
+#define FP_COUNT_PER_SEC   46875000.0f  /* OS_CPU_COUNTER                          */
+#define FP_TICK_MIN          (1.0f / 240.0f)
+#define FP_TICK_MAX          (1.0f / 10.0f)
+#define FP_CONFIG_PER_FRAME  4      /* cached settings re-read per camera update       */
+
+/* Build with -DFP_STATS=1 to log camera statistics (late-latch input
+ * age, wall probe cost, viewport writes) when FP mode exits */
+#ifndef FP_STATS
+#define FP_STATS 0
+#endif
+
+/* Build with -DFP_PROFILER=1 to time each stage of the camera update
+ * with the native clock and append p50/p99 to fp_profile.txt in the mod
+ * folder when FP mode exits.  The FP_PROF_* macros compile to nothing
+ * otherwise. */
+#ifndef FP_PROFILER
+#define FP_PROFILER 0
+#endif
+#define FP_PROF_CONFIG     0
+#define FP_PROF_INPUT      1
+#define FP_PROF_WATER      2
+#define FP_PROF_EYE        3
+#define FP_PROF_SMOOTH     4
+#define FP_PROF_COLLIDE    5
+#define FP_PROF_ROTATION   6
+#define FP_PROF_APPLY      7
+#define FP_PROF_TOTAL      8
+#define FP_PROF_STAGES     9
+#define FP_PROF_NAMES      "config\ninput\nwater\neye\nsmooth\ncollide\nrotation\napply\ntotal"
+#define FP_PROF_BUCKETS  128      /* 4 per power of two of nanoseconds */
+
+/* Actor culling against the FP view (actor_culling option) */
+#define FP_CULL_RADIUS           500.0f   /* bounding radius assumed per unit of model scale (not measured) */
+#define FP_CULL_ASPECT_MAX  (32.0f / 9.0f)  /* widest window the cone has to cover             */
+
+/* One-Euro look filter (look_filter option) */
+#define FP_EURO_D_CUTOFF           1.0f   /* Hz, smoothing of the speed estimate              */
+#define FP_EURO_MOUSE_X            0      /* fp_euro[] axes                                    */
+#define FP_EURO_MOUSE_Y            1
+#define FP_EURO_STICK_X            2
+#define FP_EURO_STICK_Y            3
+
+/* Wall probe (wall_probe option) */
+#define FP_PROBE_RADIUS           24.0f   /* clearance kept between eye and walls (near plane) */
+#define FP_PROBE_CACHE_DIST        2.0f   /* reuse last hit while both ends move less (units)  */
+#define FP_PROBE_CACHE_COS      0.99985f  /* ... and the probe turns less than 1 degree        */
+#define FP_PROBE_CACHE_FRAMES     15      /* re-probe at least this often (moving platforms)   */
+#define FP_PROBE_FLAGS             0      /* collision tri flags to ignore (0 = test all)      */
+
+/* Synthetic head motion (see oscillator bank below) */
+#define FP_OSC_FADE_SPEED          8.0f   /* idle <-> walk cross-fade and fade-in speed       */
+#define FP_OSC_MAX_TERMS           8      /* phase accumulators per form profile              */
+
+/* Head-bone calibration (calibrate option), cached in the mod folder */
+#define FP_CALIB_MAGIC    0x46504342u  /* "FPCB"                                   */
+#define FP_CALIB_VERSION  1
+#define FP_CALIB_FORMS    8            /* indexed by transformation (TRANSFORM_*)  */
+#define FP_CALIB_FRAMES   90           /* idle bone samples per form               */
+#define FP_CALIB_WORDS    (3 + FP_CALIB_FORMS * 3 + 1) /* header, fwd/lat/up, checksum */
+
 #define FP_FLIGHT_ROLL_SCALE       0.25f  /* roll = turn_rate * this (deg roll per deg/sec)    */
 #define FP_FLIGHT_ROLL_MAX        30.0f  /* max flight roll in degrees                        */
 
@@ -154,18 +206,131 @@ static s32 fp_last_map;
 static u32 fp_last_transformation;
 static s32 fp_prev_toggle_held;          /* for rising-edge detection    */
 static f32 fp_smooth_y;                 /* smoothed eye Y position       */
-static f32 fp_smooth_roll;              /* smoothed roll angle           */
-static f32 fp_bob_phase;               /* synthetic bob sine phase (degrees) */
-static f32 fp_bob_strength;            /* 0..1, fades in/out with movement   */
+static f32 fp_tilt_q[4];               /* smoothed body tilt quaternion */
+static f32 fp_osc_phase[FP_OSC_MAX_TERMS]; /* per-oscillator phase (degrees) */
+static f32 fp_bob_strength;            /* 0..1, fades in after FP entry      */
+static f32 fp_osc_walk_mix;            /* 0 = idle terms, 1 = walk terms     */
+static f32 fp_uw_yaw_vel;             /* underwater spring-back velocities  */
+static f32 fp_uw_pitch_vel;
 static f32 fp_synth_roll;             /* synthetic roll offset (degrees)    */
 static f32 fp_prev_yaw;              /* previous frame yaw for turn rate   */
-static f32 fp_saved_fov;             /* original FOV to restore on exit    */
+static f32 fp_saved_fov;             /* game's FOV to restore on exit      */
+static s32 fp_fov_writing;           /* our own viewport_setFOVy           */
 static s32 fp_restore_after_transition; /* re-enter FP when transition ends */
 static f32 fp_restore_pitch;         /* saved pitch for transition restore */
 static s32 fp_was_in_water;          /* previous frame water state         */
 static s32 fp_water_exit_frames;     /* frames since leaving water         */
 static s32 fp_effective_water;       /* combined waterState + swim anim    */
 
+/* One-Euro look filter: per axis, the look still owed to the output
+ * (raw minus filtered angle) and the smoothed look speed (deg/s) */
+typedef struct {
+    f32 owed;
+    f32 speed;
+} FpEuroAxis;
+
+static FpEuroAxis fp_euro[4];
+static s32 fp_euro_on;
+static f32 fp_euro_cutoff;           /* min cutoff (Hz) at rest            */
+static f32 fp_euro_beta;             /* cutoff added per deg/s of speed    */
+static u32 fp_euro_mouse_count;      /* osGetCount() at the last mouse step */
+
+/* Mouse look settings, refreshed every camera update so the render-time
+ * re-sample applies the same sensitivity and locks */
+static s32 fp_mouse_on;
+static f32 fp_mouse_scale_x, fp_mouse_scale_y; /* degrees per count, Y sign = invert */
+static s32 fp_mouse_yaw_free;        /* 0 in Classic / flight (yaw locked) */
+static s32 fp_mouse_pitch_free;      /* 0 while firing eggs                */
+
+/* This tick's camera orientation, for the render-time mouse latch */
+static s32 fp_cam_valid;             /* a camera update has run since entry */
+static s32 fp_cam_render_done;       /* render hook already ran this tick  */
+static u32 fp_cam_count;             /* osGetCount() at the camera update  */
+static f32 fp_cam_tick;              /* measured seconds between updates   */
+static f32 fp_cam_yaw;               /* viewport yaw                       */
+static f32 fp_cam_look[4];           /* pitch * tilt * roll quaternion     */
+/* Wall probe: inputs and result of the last real collision query */
+static s32 fp_probe_valid;
+static s32 fp_probe_age;             /* frames the cached result was reused */
+static f32 fp_probe_from[3];
+static f32 fp_probe_to[3];
+static f32 fp_probe_dir[3];          /* unit from -> eye of the last query  */
+static f32 fp_probe_frac;            /* clear fraction of from -> eye       */
+/* Specialised camera update (see FP_UPDATE_VARIANT) */
+static s32 fp_update_variant;        /* index into fp_update_variants      */
+static s32 fp_capture_mode;          /* mouse_capture last sent to native  */
+
+/* Depth range: the game's own near/far and what FP mode put in its place */
+static f32 fp_depth_game_near;
+static f32 fp_depth_game_far;
+static s32 fp_depth_applied;         /* viewport holds fp_depth_near       */
+static f32 fp_depth_near;
+static s32 fp_depth_writing;         /* our own viewport_setNearAndFar     */
+
+/* Bones-only player model */
+static s32 fp_bones_only;            /* discard this draw's output         */
+static u8 **fp_model_gfx;            /* baModel_draw's output cursors ...  */
+static u8 **fp_model_mtx;
+static u8 **fp_model_vtx;
+static u8  *fp_model_gfx_start;      /* ... and where they started         */
+static u8  *fp_model_mtx_start;
+static u8  *fp_model_vtx_start;
+
+/* Actor culling: view cone of the frame being drawn */
+static s32 fp_cull_valid;
+static s32 fp_in_actor_draw;
+static s32 fp_cull_depth;            /* modelRender_draw nesting           */
+static s32 fp_cull_discard;          /* outermost model draw gets rewound  */
+static f32 fp_cull_eye[3];
+static f32 fp_cull_fwd[3];
+static f32 fp_cull_sin;              /* half-angle of the cone around the  */
+static f32 fp_cull_cos;              /* whole view rectangle, any roll     */
+static u8 **fp_cull_gfx;
+static u8 **fp_cull_mtx;
+static u8  *fp_cull_gfx_start;
+static u8  *fp_cull_mtx_start;
+static u32 fp_cull_frame;            /* actors culled since the last frame */
+
+/* Published for other mods (fp_camera_api.h) */
+static FpCameraState fp_state;
+
+/* Head-bone calibration: mean bone offset from the player origin while
+ * idle, in the player's facing frame (forward, lateral, up) */
+static u32 fp_calib_valid;           /* bit per transformation             */
+static u32 fp_calib_session;         /* forms calibrated since boot        */
+static f32 fp_calib_off[FP_CALIB_FORMS][3];
+static s32 fp_calib_form;            /* form being sampled, 0 = none       */
+static s32 fp_calib_count;
+static f32 fp_calib_sum[3];
+#if FP_PROFILER
+static u32 fp_prof_start[FP_PROF_STAGES];
+static u32 fp_prof_hist[FP_PROF_STAGES][FP_PROF_BUCKETS];
+static u32 fp_prof_max[FP_PROF_STAGES];
+#define FP_PROF_BEGIN(stage)  (fp_prof_start[stage] = prof_clock_ns())
+#define FP_PROF_END(stage)    fp_prof_record(stage, prof_clock_ns() - fp_prof_start[stage])
+#else
+#define FP_PROF_BEGIN(stage)  ((void)0)
+#define FP_PROF_END(stage)    ((void)0)
+#endif
+#if FP_STATS
+static u32 fp_model_draws[8];        /* player draws per transformation    */
+static u32 fp_model_cmds[8];         /* ... and top-level Gfx commands     */
+static u32 fp_cull_frames;           /* frames with a view cone            */
+static u32 fp_cull_tested;           /* actor models tested                */
+static u32 fp_cull_culled;           /* ... and not submitted              */
+static u32 fp_cull_max;              /* most culled in one frame           */
+static u32 fp_vp_writes;             /* FOV sets actually issued           */
+static u32 fp_vp_skipped;            /* ... and skipped as no-ops          */
+static u32 fp_variant_frames[8];     /* per update variant                 */
+static u32 fp_variant_cycles[8];
+static u32 fp_probe_runs;            /* real collision queries              */
+static u32 fp_probe_reused;          /* frames served from the cache        */
+static u32 fp_probe_cycles;          /* osGetCount ticks spent in queries   */
+static u32 fp_latch_frames;          /* render hooks that re-sampled mouse */
+static u32 fp_latch_moved;           /* ... and found new motion           */
+static f32 fp_latch_age_sum;         /* seconds between update and latch   */
+#endif
+
 /* ------------------------------------------------------------------ */
 /* Helpers                                                             */
 /* ------------------------------------------------------------------ */
@@ -176,30 +341,217 @@ static f32 fp_clamp(f32 val, f32 lo, f32 hi) {
     return val;
 }
 
+/* ------------------------------------------------------------------ */
+/* Filters — exact in dt, so smoothing looks the same at any frame rate */
+/* ------------------------------------------------------------------ */
+
+/* e^-x for x >= 0 (the mod has no libm).  Splits off the integer power
+ * of two and evaluates 2^-f with a 7th-order series; error ~1e-6. */
+static f32 fp_exp_neg(f32 x) {
+    union { f32 f; u32 u; } scale;
+    f32 y, t;
+    s32 n;
+
+    if (x <= 0.0f)
+        return 1.0f;
+    y = x * 1.44269504f;                    /* log2(e) */
+    if (y >= 126.0f)
+        return 0.0f;
+    n = (s32)y;
+    t = (y - (f32)n) * 0.69314718f;         /* 0 <= t < ln 2 */
+    scale.u = (u32)(127 - n) << 23;         /* 2^-n */
+    return ((((((((-1.0f / 5040.0f) * t + (1.0f / 720.0f)) * t - (1.0f / 120.0f)) * t
+             + (1.0f / 24.0f)) * t - (1.0f / 6.0f)) * t + 0.5f) * t - 1.0f) * t + 1.0f)
+           * scale.f;
+}
+
+/* Blend factor for exponential decay at `rate` per second: moving
+ * `alpha` of the way toward a target every frame converges identically
+ * whether dt is 1/20 or 1/360 s (unlike rate * dt). */
+static f32 fp_decay_alpha(f32 rate, f32 dt) {
+    return 1.0f - fp_exp_neg(rate * dt);
+}
+
+/* Critically damped spring: advance the offset from the target `d`
+ * (with velocity *vel) by dt, exactly.  Settles without overshoot. */
+static f32 fp_spring_step(f32 d, f32 *vel, f32 omega, f32 dt) {
+    f32 decay = fp_exp_neg(omega * dt);
+    f32 temp = (*vel + omega * d) * dt;
+    *vel = (*vel - omega * temp) * decay;
+    return (d + temp) * decay;
+}
+
+/* One-Euro smoothing factor for a first-order low-pass at this cutoff */
+static f32 fp_euro_alpha(f32 cutoff, f32 dt) {
+    f32 tau = 1.0f / (6.2831853f * cutoff);
+    return 1.0f / (1.0f + tau / dt);
+}
+
+/* One-Euro filter on relative look input: takes this step's raw angle
+ * delta and returns the filtered delta.  The cutoff rises with look
+ * speed, so slow aiming is steadied and fast turns keep up. */
+static f32 fp_euro_step(FpEuroAxis *ax, f32 delta, f32 dt) {
+    f32 speed, out;
+
+    if (!fp_euro_on || dt <= 0.0f)
+        return delta;
+    ax->speed += (delta / dt - ax->speed) * fp_euro_alpha(FP_EURO_D_CUTOFF, dt);
+    speed = ax->speed < 0.0f ? -ax->speed : ax->speed;
+    ax->owed += delta;
+    out = ax->owed * fp_euro_alpha(fp_euro_cutoff + fp_euro_beta * speed, dt);
+    ax->owed -= out;
+    return out;
+}
+
+static void fp_euro_reset_axis(FpEuroAxis *ax) {
+    ax->owed = 0.0f;
+    ax->speed = 0.0f;
+}
+
+static void fp_euro_reset(void) {
+    s32 i;
+
+    for (i = 0; i < 4; i++)
+        fp_euro_reset_axis(&fp_euro[i]);
+    fp_euro_mouse_count = 0;
+}
+
+/* Wrap an angle difference into -180..180 */
+static f32 fp_wrap_deg(f32 deg) {
+    while (deg > 180.0f)  deg -= 360.0f;
+    while (deg < -180.0f) deg += 360.0f;
+    return deg;
+}
+
+static f32 fp_atan_poly_deg(f32 a) {
+    /* atan(a) for 0 <= a <= 1 (A&S 4.4.49), good to ~0.001 degrees.
+     * Accurate enough to round-trip the Euler angles fed to the viewport. */
+    f32 s = a * a;
+    return ((((1.1937633f * s - 4.8777616f) * s + 10.3213190f) * s
+             - 18.9247673f) * s + 57.2881019f) * a;
+}
+
 static f32 fp_atan2_deg(f32 y, f32 x) {
-    /* Quarter-circle polynomial atan approximation, good to ~0.3 degrees */
     f32 abs_x = (x < 0.0f) ? -x : x;
     f32 abs_y = (y < 0.0f) ? -y : y;
-    f32 a, s, r;
+    f32 r;
 
     if (abs_x < 0.0001f && abs_y < 0.0001f)
         return 0.0f;
 
-    if (abs_x >= abs_y) {
-        a = abs_y / abs_x;
-        s = a * a;
-        r = ((-12.88f * s + 56.85f) * s - 0.09f) * a;
-    } else {
-        a = abs_x / abs_y;
-        s = a * a;
-        r = 90.0f - ((-12.88f * s + 56.85f) * s - 0.09f) * a;
-    }
+    if (abs_x >= abs_y)
+        r = fp_atan_poly_deg(abs_y / abs_x);
+    else
+        r = 90.0f - fp_atan_poly_deg(abs_x / abs_y);
 
     if (x < 0.0f) r = 180.0f - r;
     if (y < 0.0f) r = -r;
     return r;
 }
 
+/* ------------------------------------------------------------------ */
+/* Quaternions (w, x, y, z) — camera orientation composition           */
+/* ------------------------------------------------------------------ */
+
+#define FP_AXIS_X 0
+#define FP_AXIS_Y 1
+#define FP_AXIS_Z 2
+
+static void fp_quat_identity(f32 q[4]) {
+    q[0] = 1.0f;
+    q[1] = 0.0f;
+    q[2] = 0.0f;
+    q[3] = 0.0f;
+}
+
+/* Rotation of `deg` degrees about a single viewport axis */
+static void fp_quat_axis(f32 q[4], s32 axis, f32 deg) {
+    f32 half = deg * 0.5f;
+    q[0] = ml_cos_deg(half);
+    q[1] = 0.0f;
+    q[2] = 0.0f;
+    q[3] = 0.0f;
+    q[1 + axis] = ml_sin_deg(half);
+}
+
+/* dst = a * b (dst may alias either input) */
+static void fp_quat_mul(f32 dst[4], const f32 a[4], const f32 b[4]) {
+    f32 w = a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3];
+    f32 x = a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2];
+    f32 y = a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1];
+    f32 z = a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0];
+    dst[0] = w;
+    dst[1] = x;
+    dst[2] = y;
+    dst[3] = z;
+}
+
+static void fp_quat_normalize(f32 q[4]) {
+    f32 len_sq = q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3];
+    f32 inv;
+
+    if (len_sq < 0.000001f) {
+        fp_quat_identity(q);
+        return;
+    }
+    inv = 1.0f / gu_sqrtf(len_sq);
+    q[0] *= inv;
+    q[1] *= inv;
+    q[2] *= inv;
+    q[3] *= inv;
+}
+
+/* Shortest-path slerp from `from` toward `to` by t (0..1), in place */
+static void fp_quat_slerp(f32 from[4], const f32 to[4], f32 t) {
+    f32 target[4];
+    f32 dot = from[0] * to[0] + from[1] * to[1] + from[2] * to[2] + from[3] * to[3];
+    f32 wa, wb;
+    s32 i;
+
+    /* q and -q are the same rotation; take the short way round */
+    for (i = 0; i < 4; i++)
+        target[i] = (dot < 0.0f) ? -to[i] : to[i];
+    if (dot < 0.0f) dot = -dot;
+
+    if (dot > 0.9995f) {
+        /* Nearly parallel (the common per-frame case): nlerp is exact enough */
+        wa = 1.0f - t;
+        wb = t;
+    } else {
+        f32 theta = fp_atan2_deg(gu_sqrtf(1.0f - dot * dot), dot);
+        f32 inv_sin = 1.0f / ml_sin_deg(theta);
+        wa = ml_sin_deg((1.0f - t) * theta) * inv_sin;
+        wb = ml_sin_deg(t * theta) * inv_sin;
+    }
+
+    for (i = 0; i < 4; i++)
+        from[i] = from[i] * wa + target[i] * wb;
+    fp_quat_normalize(from);
+}
+
+/* Convert to the (pitch, yaw, roll) triple viewport_setRotation_vec3f takes,
+ * composed as yaw (Y) then pitch (X) then roll (Z).  Of the two equivalent
+ * triples, picks the one whose yaw is nearest 0 so flips past vertical keep
+ * the yaw continuous instead of jumping by 180. */
+static void fp_quat_to_euler(const f32 q[4], f32 euler[3]) {
+    f32 w = q[0], x = q[1], y = q[2], z = q[3];
+    f32 m02 = 2.0f * (x * z + w * y);
+    f32 m22 = 1.0f - 2.0f * (x * x + y * y);
+    f32 m12 = 2.0f * (y * z - w * x);
+    f32 m10 = 2.0f * (x * y + w * z);
+    f32 m11 = 1.0f - 2.0f * (x * x + z * z);
+
+    euler[0] = fp_atan2_deg(-m12, gu_sqrtf(m10 * m10 + m11 * m11));
+    euler[1] = fp_atan2_deg(m02, m22);
+    euler[2] = fp_atan2_deg(m10, m11);
+
+    if (euler[1] > 90.0f || euler[1] < -90.0f) {
+        euler[0] = ((euler[0] < 0.0f) ? -180.0f : 180.0f) - euler[0];
+        euler[1] = fp_wrap_deg(euler[1] + 180.0f);
+        euler[2] = fp_wrap_deg(euler[2] + 180.0f);
+    }
+}
+
 /* Geometric roll from arm bone positions (works during normal walking/tilting) */
 static f32 fp_get_body_roll(void) {
     f32 left[3], right[3];
@@ -237,28 +589,716 @@ static f32 fp_get_body_pitch(void) {
     return -fp_atan2_deg(forward, dy);
 }
 
-/* Synthetic vertical bob for pumpkin */
-static f32 fp_synthetic_bob(f32 dt) {
-    f32 freq, amp;
-    s32 moving = (bastick_getZone() > 0);
+/* ------------------------------------------------------------------ */
+/* Config cache — recomp_get_config_* looks each setting up by name,   */
+/* and the camera update uses some forty.  All are read on FP entry,   */
+/* then FP_CONFIG_PER_FRAME of them per update in turn, so a change in */
+/* the config menu lands within a dozen frames whether or not the game */
+/* is paused behind it.                                                */
+/* ------------------------------------------------------------------ */
+
+/* Enum options (recomp_get_config_u32) */
+#define FP_OPT_CAMERA_MODE              0
+#define FP_OPT_HEAD_TRACKING            1
+#define FP_OPT_WALL_PROBE               2
+#define FP_OPT_ACTOR_CULLING            3
+#define FP_OPT_BONES_ONLY               4
+#define FP_OPT_DEPTH_RANGE              5
+#define FP_OPT_CALIBRATE                6
+#define FP_OPT_LOOK_FILTER              7
+#define FP_OPT_MOUSE_ENABLED            8
+#define FP_OPT_MOUSE_LATE_LATCH         9
+#define FP_OPT_MOUSE_INVERT_Y          10
+#define FP_OPT_MOUSE_CAPTURE           11
+#define FP_OPT_COUNT                   12
+
+/* Number options (recomp_get_config_double) */
+#define FP_SLIDER_FOV                   0
+#define FP_SLIDER_LOOK_FILTER_CUTOFF    1
+#define FP_SLIDER_LOOK_FILTER_BETA      2
+#define FP_SLIDER_MOUSE_SENSITIVITY_X   3
+#define FP_SLIDER_MOUSE_SENSITIVITY_Y   4
+#define FP_SLIDER_BANJO_HEIGHT          5
+#define FP_SLIDER_BANJO_FORWARD         6
+#define FP_SLIDER_BANJO_BOB             7
+#define FP_SLIDER_BANJO_ROLL            8
+#define FP_SLIDER_BANJO_PITCH           9
+#define FP_SLIDER_SWIM_SURFACE_HEIGHT  10
+#define FP_SLIDER_SWIM_SURFACE_FORWARD 11
+#define FP_SLIDER_SWIM_UNDER_HEIGHT    12
+#define FP_SLIDER_SWIM_UNDER_FORWARD   13
+#define FP_SLIDER_TROT_HEIGHT          14
+#define FP_SLIDER_TROT_FORWARD         15
+#define FP_SLIDER_BOOTS_HEIGHT         16
+#define FP_SLIDER_BOOTS_FORWARD        17
+#define FP_SLIDER_FLIGHT_HEIGHT        18
+#define FP_SLIDER_FLIGHT_FORWARD       19
+#define FP_SLIDER_TERMITE_HEIGHT       20
+#define FP_SLIDER_TERMITE_FORWARD      21
+#define FP_SLIDER_PUMPKIN_HEIGHT       22
+#define FP_SLIDER_PUMPKIN_FORWARD      23
+#define FP_SLIDER_CROC_HEIGHT          24
+#define FP_SLIDER_CROC_FORWARD         25
+#define FP_SLIDER_WALRUS_HEIGHT        26
+#define FP_SLIDER_WALRUS_FORWARD       27
+#define FP_SLIDER_BEE_HEIGHT           28
+#define FP_SLIDER_BEE_FORWARD          29
+#define FP_SLIDER_COUNT                30
+
+static const char *const fp_opt_keys[FP_OPT_COUNT] = {
+    [FP_OPT_CAMERA_MODE]      = "camera_mode",
+    [FP_OPT_HEAD_TRACKING]    = "head_tracking",
+    [FP_OPT_WALL_PROBE]       = "wall_probe",
+    [FP_OPT_ACTOR_CULLING]    = "actor_culling",
+    [FP_OPT_BONES_ONLY]       = "bones_only",
+    [FP_OPT_DEPTH_RANGE]      = "depth_range",
+    [FP_OPT_CALIBRATE]        = "calibrate",
+    [FP_OPT_LOOK_FILTER]      = "look_filter",
+    [FP_OPT_MOUSE_ENABLED]    = "mouse_enabled",
+    [FP_OPT_MOUSE_LATE_LATCH] = "mouse_late_latch",
+    [FP_OPT_MOUSE_INVERT_Y]   = "mouse_invert_y",
+    [FP_OPT_MOUSE_CAPTURE]    = "mouse_capture",
+};
+
+static const char *const fp_slider_keys[FP_SLIDER_COUNT] = {
+    [FP_SLIDER_FOV]                  = "fov",
+    [FP_SLIDER_LOOK_FILTER_CUTOFF]   = "look_filter_cutoff",
+    [FP_SLIDER_LOOK_FILTER_BETA]     = "look_filter_beta",
+    [FP_SLIDER_MOUSE_SENSITIVITY_X]  = "mouse_sensitivity_x",
+    [FP_SLIDER_MOUSE_SENSITIVITY_Y]  = "mouse_sensitivity_y",
+    [FP_SLIDER_BANJO_HEIGHT]         = "banjo_height",
+    [FP_SLIDER_BANJO_FORWARD]        = "banjo_forward",
+    [FP_SLIDER_BANJO_BOB]            = "banjo_bob",
+    [FP_SLIDER_BANJO_ROLL]           = "banjo_roll",
+    [FP_SLIDER_BANJO_PITCH]          = "banjo_pitch",
+    [FP_SLIDER_SWIM_SURFACE_HEIGHT]  = "swim_surface_height",
+    [FP_SLIDER_SWIM_SURFACE_FORWARD] = "swim_surface_forward",
+    [FP_SLIDER_SWIM_UNDER_HEIGHT]    = "swim_under_height",
+    [FP_SLIDER_SWIM_UNDER_FORWARD]   = "swim_under_forward",
+    [FP_SLIDER_TROT_HEIGHT]          = "trot_height",
+    [FP_SLIDER_TROT_FORWARD]         = "trot_forward",
+    [FP_SLIDER_BOOTS_HEIGHT]         = "boots_height",
+    [FP_SLIDER_BOOTS_FORWARD]        = "boots_forward",
+    [FP_SLIDER_FLIGHT_HEIGHT]        = "flight_height",
+    [FP_SLIDER_FLIGHT_FORWARD]       = "flight_forward",
+    [FP_SLIDER_TERMITE_HEIGHT]       = "termite_height",
+    [FP_SLIDER_TERMITE_FORWARD]      = "termite_forward",
+    [FP_SLIDER_PUMPKIN_HEIGHT]       = "pumpkin_height",
+    [FP_SLIDER_PUMPKIN_FORWARD]      = "pumpkin_forward",
+    [FP_SLIDER_CROC_HEIGHT]          = "croc_height",
+    [FP_SLIDER_CROC_FORWARD]         = "croc_forward",
+    [FP_SLIDER_WALRUS_HEIGHT]        = "walrus_height",
+    [FP_SLIDER_WALRUS_FORWARD]       = "walrus_forward",
+    [FP_SLIDER_BEE_HEIGHT]           = "bee_height",
+    [FP_SLIDER_BEE_FORWARD]          = "bee_forward",
+};
+
+static u32 fp_opt[FP_OPT_COUNT];
+static f32 fp_slider[FP_SLIDER_COUNT];
+static s32 fp_config_next;           /* next key to re-read                */
+
+static void fp_config_read(s32 i) {
+    if (i < FP_OPT_COUNT)
+        fp_opt[i] = recomp_get_config_u32(fp_opt_keys[i]);
+    else
+        fp_slider[i - FP_OPT_COUNT] = (f32)recomp_get_config_double(fp_slider_keys[i - FP_OPT_COUNT]);
+}
+
+static void fp_config_read_all(void) {
+    s32 i;
+
+    for (i = 0; i < FP_OPT_COUNT + FP_SLIDER_COUNT; i++)
+        fp_config_read(i);
+    fp_config_next = 0;
+}
+
+static void fp_config_step(void) {
+    s32 i;
+
+    for (i = 0; i < FP_CONFIG_PER_FRAME; i++) {
+        fp_config_read(fp_config_next);
+        if (++fp_config_next == FP_OPT_COUNT + FP_SLIDER_COUNT)
+            fp_config_next = 0;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Oscillator bank — synthetic head motion for forms without usable    */
+/* head bones.  Each term adds amp * sin(harmonic * phase + phase_ofs) */
+/* to one axis; harmonic 0 with a 90 degree offset is a constant.      */
+/* ------------------------------------------------------------------ */
+
+#define FP_OSC_UP    0   /* eye Y                                   */
+#define FP_OSC_SIDE  1   /* eye offset perpendicular to camera yaw  */
+#define FP_OSC_ROLL  2   /* synthetic roll (degrees)                */
+
+#define FP_OSC_IDLE  0
+#define FP_OSC_WALK  1
+
+typedef struct {
+    u8  axis;       /* FP_OSC_UP / FP_OSC_SIDE / FP_OSC_ROLL       */
+    u8  state;      /* FP_OSC_IDLE / FP_OSC_WALK                   */
+    u8  harmonic;   /* multiple of the accumulated phase           */
+    f32 freq;       /* phase speed, deg/sec                        */
+    f32 amp;        /* units (UP/SIDE) or degrees (ROLL)           */
+    f32 phase;      /* phase offset, degrees                       */
+} FpOscTerm;
+
+typedef struct {
+    const FpOscTerm *terms;
+    s32 count;
+} FpOscProfile;
+
+/* Pumpkin: slow idle hop, rapid small walk bob (50 cycles / 7.3 sec) */
+static const FpOscTerm fp_osc_pumpkin_terms[] = {
+    { FP_OSC_UP,   FP_OSC_IDLE, 1,  310.0f,  3.0f,  0.0f },
+    { FP_OSC_UP,   FP_OSC_WALK, 1, 2466.0f,  1.5f,  0.0f },
+};
+
+/* Termite: idle side-to-side sway (10 cycles / 12 sec) dipping down at
+ * the extremes, walking bob like the pumpkin */
+static const FpOscTerm fp_osc_termite_terms[] = {
+    { FP_OSC_SIDE, FP_OSC_IDLE, 1,  300.0f,  3.0f,  0.0f },
+    { FP_OSC_UP,   FP_OSC_IDLE, 2,  300.0f, -1.0f, 90.0f },
+    { FP_OSC_UP,   FP_OSC_IDLE, 0,  300.0f, -1.0f, 90.0f },
+    { FP_OSC_UP,   FP_OSC_WALK, 1, 2466.0f,  1.5f,  0.0f },
+};
+
+/* Bee: asymmetric idle sway sin(p) + 0.35*sin(3p) (double-left, single-right
+ * bounce, 10 cycles / 30 sec), walking body-dip roll (10 cycles / 5 sec) */
+static const FpOscTerm fp_osc_bee_terms[] = {
+    { FP_OSC_SIDE, FP_OSC_IDLE, 1,  120.0f,  3.0f,  0.0f },
+    { FP_OSC_SIDE, FP_OSC_IDLE, 3,  120.0f,  1.05f, 0.0f },
+    { FP_OSC_ROLL, FP_OSC_WALK, 1,  720.0f,  3.0f,  0.0f },
+};
+
+/* Washing machine: same idle harmonic sway as the bee but wider, walking
+ * side-to-side sway with an upward arc in the middle (20 cycles / 10 sec) */
+static const FpOscTerm fp_osc_washup_terms[] = {
+    { FP_OSC_SIDE, FP_OSC_IDLE, 1,  120.0f,  5.0f,  0.0f },
+    { FP_OSC_SIDE, FP_OSC_IDLE, 3,  120.0f,  1.75f, 0.0f },
+    { FP_OSC_SIDE, FP_OSC_WALK, 1,  720.0f, 10.0f,  0.0f },
+    { FP_OSC_UP,   FP_OSC_WALK, 2,  720.0f,  3.5f, 90.0f },
+    { FP_OSC_UP,   FP_OSC_WALK, 0,  720.0f,  3.5f, 90.0f },
+};
+
+/* Talon Trot: running bob (50 bobs / 50 sec), still when idle */
+static const FpOscTerm fp_osc_trot_terms[] = {
+    { FP_OSC_UP,   FP_OSC_WALK, 1,  360.0f,  2.0f,  0.0f },
+};
+
+#define FP_OSC_PROFILE(t) { t, (s32)(sizeof(t) / sizeof(t[0])) }
+
+static const FpOscProfile fp_osc_pumpkin = FP_OSC_PROFILE(fp_osc_pumpkin_terms);
+static const FpOscProfile fp_osc_termite = FP_OSC_PROFILE(fp_osc_termite_terms);
+static const FpOscProfile fp_osc_bee     = FP_OSC_PROFILE(fp_osc_bee_terms);
+static const FpOscProfile fp_osc_washup  = FP_OSC_PROFILE(fp_osc_washup_terms);
+static const FpOscProfile fp_osc_trot    = FP_OSC_PROFILE(fp_osc_trot_terms);
+
+static void fp_osc_reset(void) {
+    s32 i;
+    for (i = 0; i < FP_OSC_MAX_TERMS; i++)
+        fp_osc_phase[i] = 0.0f;
+    fp_bob_strength = 0.0f;
+    fp_osc_walk_mix = 0.0f;
+}
+
+/* Evaluate every active term of a profile and add it to the eye position
+ * (UP/SIDE) and fp_synth_roll (ROLL).  Idle and walk terms cross-fade. */
+static void fp_osc_apply(const FpOscProfile *prof, s32 moving, f32 dt, f32 eye_pos[3]) {
+    f32 sum[3] = { 0.0f, 0.0f, 0.0f };
+    f32 weight[2];
+    f32 alpha = fp_decay_alpha(FP_OSC_FADE_SPEED, dt);
+    s32 i;
+
+    fp_bob_strength += (1.0f - fp_bob_strength) * alpha;
+    fp_osc_walk_mix += ((moving ? 1.0f : 0.0f) - fp_osc_walk_mix) * alpha;
+
+    weight[FP_OSC_IDLE] = (1.0f - fp_osc_walk_mix) * fp_bob_strength;
+    weight[FP_OSC_WALK] = fp_osc_walk_mix * fp_bob_strength;
+
+    for (i = 0; i < prof->count && i < FP_OSC_MAX_TERMS; i++) {
+        const FpOscTerm *t = &prof->terms[i];
+        f32 w = weight[t->state];
+        if (w < 0.001f)
+            continue;
+        fp_osc_phase[i] += t->freq * dt;
+        if (fp_osc_phase[i] >= 360.0f) fp_osc_phase[i] -= 360.0f;
+        sum[t->axis] += ml_sin_deg((f32)t->harmonic * fp_osc_phase[i] + t->phase) * t->amp * w;
+    }
+
+    eye_pos[1] += sum[FP_OSC_UP];
+    if (sum[FP_OSC_SIDE] != 0.0f) {
+        eye_pos[0] += -ml_cos_deg(fp_yaw) * sum[FP_OSC_SIDE];
+        eye_pos[2] +=  ml_sin_deg(fp_yaw) * sum[FP_OSC_SIDE];
+    }
+    fp_synth_roll += sum[FP_OSC_ROLL];
+}
+
+/* ------------------------------------------------------------------ */
+/* FOV write — skip the set when the viewport already holds the value. */
+/* The game's own FOV changes are caught by the viewport_setFOVy hook. */
+/* ------------------------------------------------------------------ */
+
+static void fp_viewport_set_fov(f32 fov) {
+    if (viewport_getFOVy() == fov) {
+#if FP_STATS
+        fp_vp_skipped++;
+#endif
+        return;
+    }
+    fp_fov_writing = 1;
+    viewport_setFOVy(fov);
+    fp_fov_writing = 0;
+#if FP_STATS
+    fp_vp_writes++;
+#endif
+}
 
-    if (moving) {
-        freq = FP_SYNTH_BOB_PUMPKIN_WALK;
-        amp  = FP_SYNTH_BOB_PUMPKIN_AMP;
+/* ------------------------------------------------------------------ */
+/* Head-bone calibration                                               */
+/* ------------------------------------------------------------------ */
+/* With the calibrate option on, each bone-tracked form samples its head
+ * bone for FP_CALIB_FRAMES idle frames. The mean lateral offset of the
+ * bone from the body axis is the correction that centres the eye on the
+ * head; forward/up are logged for tuning the sliders. Results are saved
+ * to the mod folder and loaded at init, so later sessions start
+ * calibrated without sampling again. */
+
+typedef union { f32 f; u32 u; } FpWord;
+
+static u32 fp_calib_checksum(const u32 *words, s32 n) {
+    u32 sum = FP_CALIB_MAGIC;
+    s32 i;
+
+    for (i = 0; i < n; i++)
+        sum = ((sum << 5) | (sum >> 27)) ^ words[i];
+    return sum;
+}
+
+static void fp_calib_load(void) {
+    u32 words[FP_CALIB_WORDS];
+    unsigned char *folder = recomp_get_mod_folder_path();
+    u32 n;
+    s32 i, j;
+
+    fp_calib_valid = 0;
+    if (!folder)
+        return;
+    n = calib_file_read(folder, words, FP_CALIB_WORDS);
+    recomp_free(folder);
+
+    if (n != FP_CALIB_WORDS || words[0] != FP_CALIB_MAGIC || words[1] != FP_CALIB_VERSION
+        || words[FP_CALIB_WORDS - 1] != fp_calib_checksum(words, FP_CALIB_WORDS - 1)) {
+        if (n > 0)
+            recomp_printf("[fp] ignoring stale calibration cache\n");
+        return;
+    }
+    fp_calib_valid = words[2];
+    for (i = 0; i < FP_CALIB_FORMS; i++) {
+        for (j = 0; j < 3; j++) {
+            FpWord w;
+            w.u = words[3 + i * 3 + j];
+            fp_calib_off[i][j] = w.f;
+        }
+    }
+}
+
+static void fp_calib_save(void) {
+    u32 words[FP_CALIB_WORDS];
+    unsigned char *folder = recomp_get_mod_folder_path();
+    s32 i, j;
+
+    if (!folder)
+        return;
+    words[0] = FP_CALIB_MAGIC;
+    words[1] = FP_CALIB_VERSION;
+    words[2] = fp_calib_valid;
+    for (i = 0; i < FP_CALIB_FORMS; i++) {
+        for (j = 0; j < 3; j++) {
+            FpWord w;
+            w.f = fp_calib_off[i][j];
+            words[3 + i * 3 + j] = w.u;
+        }
+    }
+    words[FP_CALIB_WORDS - 1] = fp_calib_checksum(words, FP_CALIB_WORDS - 1);
+    if (!calib_file_write(folder, words, FP_CALIB_WORDS))
+        recomp_printf("[fp] could not write calibration cache\n");
+    recomp_free(folder);
+}
+
+/* Feed one raw head-bone sample; call only while the player is idle */
+static void fp_calib_sample(s32 form, const f32 bone[3], const f32 player_pos[3]) {
+    f32 yaw, dx, dz;
+
+    if (form <= 0 || form >= FP_CALIB_FORMS || (fp_calib_session & (1u << form)))
+        return;
+    if (form != fp_calib_form) {
+        fp_calib_form = form;
+        fp_calib_count = 0;
+        fp_calib_sum[0] = fp_calib_sum[1] = fp_calib_sum[2] = 0.0f;
+    }
+
+    yaw = player_getYaw();
+    dx = bone[0] - player_pos[0];
+    dz = bone[2] - player_pos[2];
+    fp_calib_sum[0] += dx * ml_sin_deg(yaw) + dz * ml_cos_deg(yaw);
+    fp_calib_sum[1] += dz * ml_sin_deg(yaw) - dx * ml_cos_deg(yaw);
+    fp_calib_sum[2] += bone[1] - player_pos[1];
+    if (++fp_calib_count < FP_CALIB_FRAMES)
+        return;
+
+    fp_calib_off[form][0] = fp_calib_sum[0] / (f32)fp_calib_count;
+    fp_calib_off[form][1] = fp_calib_sum[1] / (f32)fp_calib_count;
+    fp_calib_off[form][2] = fp_calib_sum[2] / (f32)fp_calib_count;
+    fp_calib_valid |= 1u << form;
+    fp_calib_session |= 1u << form;
+    fp_calib_form = 0;
+    recomp_printf("[fp] calibrated form %d: head bone fwd %.1f lateral %.1f up %.1f\n", form,
+                  fp_calib_off[form][0], fp_calib_off[form][1], fp_calib_off[form][2]);
+    fp_calib_save();
+}
+
+/* Lateral eye shift that centres a form's eye on its head */
+static f32 fp_calib_lateral(s32 form, f32 fallback) {
+    if (form > 0 && form < FP_CALIB_FORMS && (fp_calib_valid & (1u << form)))
+        return -fp_calib_off[form][1];
+    return fallback;
+}
+
+/* Poll the native mouse and fold its deltas into fp_yaw / fp_pitch.
+ * latch selects the render-time re-poll, which only reads the motion
+ * since the frame's full poll.  Writes the applied yaw and pitch change
+ * (degrees) to out. */
+static void fp_mouse_look(f32 out[2], s32 latch) {
+    u32 now;
+    f32 dt;
+
+    out[0] = 0.0f;
+    out[1] = 0.0f;
+    if (!fp_mouse_on)
+        return;
+
+    if (latch)
+        mouse_poll_latch();
+    else
+        mouse_poll();
+    if (!mouse_is_captured()) {
+        fp_euro_reset_axis(&fp_euro[FP_EURO_MOUSE_X]);
+        fp_euro_reset_axis(&fp_euro[FP_EURO_MOUSE_Y]);
+        fp_euro_mouse_count = 0;
+        return;
+    }
+
+    /* Polls come from both the camera update and the render hook, so
+     * the filter runs on the real time between them */
+    now = osGetCount();
+    dt = fp_euro_mouse_count ? (f32)(now - fp_euro_mouse_count) / FP_COUNT_PER_SEC : FP_TICK_MIN;
+    dt = fp_clamp(dt, FP_TICK_MIN * 0.25f, FP_TICK_MAX);
+    fp_euro_mouse_count = now;
+
+    if (fp_mouse_yaw_free) {
+        out[0] = fp_euro_step(&fp_euro[FP_EURO_MOUSE_X],
+                              -(f32)mouse_get_delta_x() * fp_mouse_scale_x, dt);
+        fp_yaw += out[0];
     } else {
-        freq = FP_SYNTH_BOB_PUMPKIN_IDLE;
-        amp  = FP_SYNTH_BOB_PUMPKIN_IDLE_AMP;
+        fp_euro_reset_axis(&fp_euro[FP_EURO_MOUSE_X]);
+    }
+    if (fp_mouse_pitch_free) {
+        f32 want = fp_euro_step(&fp_euro[FP_EURO_MOUSE_Y],
+                                (f32)mouse_get_delta_y() * fp_mouse_scale_y, dt);
+        f32 pitch = fp_clamp(fp_pitch + want, FP_PITCH_MIN, FP_PITCH_MAX);
+        if (pitch != fp_pitch + want)
+            fp_euro[FP_EURO_MOUSE_Y].owed = 0.0f;   /* don't push into the limit */
+        out[1] = pitch - fp_pitch;
+        fp_pitch = pitch;
+    } else {
+        fp_euro_reset_axis(&fp_euro[FP_EURO_MOUSE_Y]);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Render-time latch base — the orientation the camera update wrote,   */
+/* which the render hook re-applies the newest mouse motion on top of  */
+/* ------------------------------------------------------------------ */
+
+static void fp_cam_store(f32 view_yaw, const f32 look[4]) {
+    u32 now = osGetCount();
+    s32 i;
+
+    if (fp_cam_valid)
+        fp_cam_tick = fp_clamp((f32)(now - fp_cam_count) / FP_COUNT_PER_SEC,
+                               FP_TICK_MIN, FP_TICK_MAX);
+    for (i = 0; i < 4; i++)
+        fp_cam_look[i] = look[i];
+    fp_cam_yaw = view_yaw;
+    fp_cam_count = now;
+    fp_cam_valid = 1;
+    fp_cam_render_done = 0;
+}
+
+static void fp_cam_reset(void) {
+    fp_cam_valid = 0;
+    fp_cam_render_done = 1;
+    fp_cam_tick = 1.0f / 30.0f;
+}
+
+/* ------------------------------------------------------------------ */
+/* Wall probe — forward offsets can push the eye through walls and     */
+/* ceilings.  Cast from inside the player's body toward the eye,       */
+/* padded by FP_PROBE_RADIUS, and pull the eye back on a hit.  The     */
+/* result is reused while neither end moves much and the direction     */
+/* holds, and refreshed every FP_PROBE_CACHE_FRAMES for moving         */
+/* platforms.                                                          */
+/* ------------------------------------------------------------------ */
+
+/* Probe start height above the player position, per FP_PROFILE_*.  It
+ * must stay inside the form's body, under its eye and over the floor,
+ * so small forms start lower; roughly 40% of the default eye height. */
+static const f32 fp_probe_body_y[] = {
+    50.0f,                       /* NONE         */
+    50.0f,                       /* BANJO        */
+    60.0f,                       /* TALON_TROT   */
+    50.0f,                       /* WADING_BOOTS */
+    50.0f,                       /* FLIGHT       */
+    18.0f,                       /* TERMITE      */
+    15.0f,                       /* PUMPKIN      */
+    35.0f,                       /* WALRUS       */
+    25.0f,                       /* CROC         */
+    22.0f,                       /* BEE          */
+    60.0f,                       /* WASHUP       */
+    30.0f,                       /* SWIM_SURFACE */
+    30.0f,                       /* UNDERWATER   */
+};
+
+static f32 fp_dist_sq(const f32 a[3], const f32 b[3]) {
+    f32 dx = a[0] - b[0];
+    f32 dy = a[1] - b[1];
+    f32 dz = a[2] - b[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+static void fp_probe_clip(const f32 from[3], f32 eye_pos[3]) {
+    f32 dir[3];
+    f32 len = gu_sqrtf(fp_dist_sq(eye_pos, from));
+    s32 i;
+
+    for (i = 0; i < 3; i++)
+        dir[i] = (len > 0.001f) ? (eye_pos[i] - from[i]) / len : 0.0f;
+
+    if (fp_probe_valid && fp_probe_age < FP_PROBE_CACHE_FRAMES
+        && fp_dist_sq(from, fp_probe_from) < FP_PROBE_CACHE_DIST * FP_PROBE_CACHE_DIST
+        && fp_dist_sq(eye_pos, fp_probe_to) < FP_PROBE_CACHE_DIST * FP_PROBE_CACHE_DIST
+        && dir[0] * fp_probe_dir[0] + dir[1] * fp_probe_dir[1] + dir[2] * fp_probe_dir[2]
+               > FP_PROBE_CACHE_COS) {
+        fp_probe_age++;
+#if FP_STATS
+        fp_probe_reused++;
+#endif
+    } else {
+        f32 end[3], normal[3];
+#if FP_STATS
+        u32 start_count = osGetCount();
+#endif
+
+        fp_probe_frac = 1.0f;
+        if (len > 0.001f) {
+            for (i = 0; i < 3; i++)
+                end[i] = eye_pos[i] + dir[i] * FP_PROBE_RADIUS;
+            if (func_80309B48((f32 *)from, end, normal, FP_PROBE_FLAGS) != 0) {
+                f32 hit = gu_sqrtf(fp_dist_sq(end, from));
+                fp_probe_frac = fp_clamp((hit - FP_PROBE_RADIUS) / len, 0.0f, 1.0f);
+            }
+        }
+
+        for (i = 0; i < 3; i++) {
+            fp_probe_from[i] = from[i];
+            fp_probe_to[i] = eye_pos[i];
+            fp_probe_dir[i] = dir[i];
+        }
+        fp_probe_valid = 1;
+        fp_probe_age = 0;
+#if FP_STATS
+        fp_probe_runs++;
+        fp_probe_cycles += osGetCount() - start_count;
+#endif
+    }
+
+    if (fp_probe_frac < 1.0f) {
+        for (i = 0; i < 3; i++)
+            eye_pos[i] = from[i] + (eye_pos[i] - from[i]) * fp_probe_frac;
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* Actor culling — actor models are re-tested against a cone around   */
+/* the final FP view, and ones fully outside have their output rewound */
+/* the same way as the bones-only player model.  The model is still    */
+/* walked on the CPU; only its RSP/RDP work is saved.                  */
+/* ------------------------------------------------------------------ */
+
+/* Cone from the final eye, rotation (pitch, yaw) and vertical FOV.  The
+ * horizontal extent depends on the window, which the mod can't see, so
+ * the cone encloses a FP_CULL_ASPECT_MAX view rectangle at any roll. */
+static void fp_cull_build(const f32 eye[3], const f32 rotation[3], f32 fovy) {
+    f32 t = ml_sin_deg(fovy * 0.5f) / ml_cos_deg(fovy * 0.5f);
+    f32 diag = gu_sqrtf(t * t * (1.0f + FP_CULL_ASPECT_MAX * FP_CULL_ASPECT_MAX));
+    f32 half = fp_atan2_deg(diag, 1.0f);
+    f32 cp = ml_cos_deg(rotation[0]);
+
+    fp_cull_eye[0] = eye[0];
+    fp_cull_eye[1] = eye[1];
+    fp_cull_eye[2] = eye[2];
+    fp_cull_fwd[0] = -ml_sin_deg(rotation[1]) * cp;
+    fp_cull_fwd[1] = -ml_sin_deg(rotation[0]);
+    fp_cull_fwd[2] = -ml_cos_deg(rotation[1]) * cp;
+    fp_cull_sin = ml_sin_deg(half);
+    fp_cull_cos = ml_cos_deg(half);
+    fp_cull_valid = 1;
+}
+
+/* 1 if a sphere is entirely outside the view cone */
+static s32 fp_cull_sphere(const f32 pos[3], f32 radius) {
+    f32 d[3], z, lat_sq;
+
+    d[0] = pos[0] - fp_cull_eye[0];
+    d[1] = pos[1] - fp_cull_eye[1];
+    d[2] = pos[2] - fp_cull_eye[2];
+    z = d[0] * fp_cull_fwd[0] + d[1] * fp_cull_fwd[1] + d[2] * fp_cull_fwd[2];
+    lat_sq = d[0] * d[0] + d[1] * d[1] + d[2] * d[2] - z * z;
+    if (lat_sq < 0.0f)
+        lat_sq = 0.0f;
+    /* distance from the cone's surface, positive outside */
+    return gu_sqrtf(lat_sq) * fp_cull_cos - z * fp_cull_sin > radius;
+}
+
+/* Rebuild the cone from what the viewport will draw this tick */
+static void fp_cull_update(void) {
+    f32 eye[3], rotation[3];
+
+#if FP_STATS
+    if (fp_cull_valid) {
+        fp_cull_frames++;
+        if (fp_cull_frame > fp_cull_max)
+            fp_cull_max = fp_cull_frame;
+    }
+#endif
+    fp_cull_frame = 0;
+    fp_cull_valid = 0;
+    if (!fp_opt[FP_OPT_ACTOR_CULLING])
+        return;
+
+    viewport_getPosition_vec3f(eye);
+    viewport_getRotation_vec3f(rotation);
+    fp_cull_build(eye, rotation, viewport_getFOVy());
+}
+
+/* ------------------------------------------------------------------ */
+/* Exported API and events (see include/fp_camera_api.h)               */
+/* ------------------------------------------------------------------ */
+
+RECOMP_DECLARE_EVENT(fp_on_enter(void));
+RECOMP_DECLARE_EVENT(fp_on_exit(void));
+RECOMP_DECLARE_EVENT(fp_on_camera_finalize(const FpCameraState *state));
+
+RECOMP_EXPORT void fp_camera_get_state(FpCameraState *out) {
+    *out = fp_state;
+}
+
+RECOMP_EXPORT s32 fp_camera_is_active(void) {
+    return fp_active;
+}
+
+/* Mirrors the eye placement switch in the camera update */
+static s32 fp_current_profile(void) {
+    s32 st;
+
+    if (fp_effective_water == 1) return FP_PROFILE_SWIM_SURFACE;
+    if (fp_effective_water == 2) return FP_PROFILE_UNDERWATER;
+    switch (player_getTransformation()) {
+        case TRANSFORM_TERMITE: return FP_PROFILE_TERMITE;
+        case TRANSFORM_PUMPKIN: return FP_PROFILE_PUMPKIN;
+        case TRANSFORM_WALRUS:  return FP_PROFILE_WALRUS;
+        case TRANSFORM_CROC:    return FP_PROFILE_CROC;
+        case TRANSFORM_BEE:     return FP_PROFILE_BEE;
+        case TRANSFORM_WASHUP:  return FP_PROFILE_WASHUP;
+    }
+    st = bs_getState();
+    if (st == BS_BTROT_IDLE || st == BS_BTROT_WALK || st == BS_BTROT_JUMP || st == BS_BTROT_SLIDE)
+        return FP_PROFILE_TALON_TROT;
+    if (st == BS_LONGLEG_IDLE || st == BS_LONGLEG_WALK || st == BS_LONGLEG_JUMP || st == BS_LONGLEG_SLIDE)
+        return FP_PROFILE_WADING_BOOTS;
+    if (st == BS_FLY || st == BS_BOMB)
+        return FP_PROFILE_FLIGHT;
+    return FP_PROFILE_BANJO;
+}
+
+/* Snapshot what the viewport will draw this tick and notify listeners */
+static void fp_publish_state(void) {
+    fp_state.active = 1;
+    fp_state.profile = fp_current_profile();
+    fp_state.transformation = player_getTransformation();
+    fp_state.frame++;
+    viewport_getPosition_vec3f(fp_state.eye);
+    viewport_getRotation_vec3f(fp_state.rotation);
+    fp_state.fov = viewport_getFOVy();
+
+    fp_on_camera_finalize(&fp_state);
+}
+
+/* ------------------------------------------------------------------ */
+/* Depth range — a closer near plane so the eye can sit right at the   */
+/* face.  The far plane stays the game's own.  Never goes past the     */
+/* game's near plane, and hands its exact values back on exit.         */
+/* ------------------------------------------------------------------ */
+
+/* Indexed by FP_PROFILE_* */
+static const f32 fp_depth_profile_near[] = {
+    12.0f,                       /* NONE         */
+    12.0f,                       /* BANJO        */
+    15.0f,                       /* TALON_TROT   */
+    12.0f,                       /* WADING_BOOTS */
+    15.0f,                       /* FLIGHT       */
+    10.0f,                       /* TERMITE      */
+    10.0f,                       /* PUMPKIN      */
+    12.0f,                       /* WALRUS       */
+    12.0f,                       /* CROC         */
+    10.0f,                       /* BEE          */
+    15.0f,                       /* WASHUP       */
+    12.0f,                       /* SWIM_SURFACE */
+    10.0f,                       /* UNDERWATER   */
+};
+
+static void fp_depth_set(f32 near, f32 far) {
+    fp_depth_writing = 1;
+    viewport_setNearAndFar(near, far);
+    fp_depth_writing = 0;
+}
+
+static void fp_depth_restore(void) {
+    if (fp_depth_applied) {
+        fp_depth_set(fp_depth_game_near, fp_depth_game_far);
+        fp_depth_applied = 0;
     }
+}
 
-    /* Ramp strength toward 1 */
-    fp_bob_strength += (1.0f - fp_bob_strength) * 8.0f * dt;
-    if (fp_bob_strength > 1.0f) fp_bob_strength = 1.0f;
+static void fp_depth_update(void) {
+    f32 near;
 
-    /* Advance phase */
-    fp_bob_phase += freq * dt;
-    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
+    if (!fp_opt[FP_OPT_DEPTH_RANGE]) {
+        fp_depth_restore();
+        return;
+    }
+
+    near = fp_depth_profile_near[fp_current_profile()];
+    if (near > fp_depth_game_near)
+        near = fp_depth_game_near;
 
-    return ml_sin_deg(fp_bob_phase) * amp * fp_bob_strength;
+    if (fp_depth_applied && near == fp_depth_near)
+        return;
+    fp_depth_set(near, fp_depth_game_far);
+    fp_depth_near = near;
+    fp_depth_applied = 1;
 }
 
 static void fp_enter(void) {
@@ -267,6 +1307,16 @@ static void fp_enter(void) {
     fp_active = 1;
     fp_restore_after_transition = 0;
     fp_saved_fov = viewport_getFOVy();
+    viewport_getNearAndFar(&fp_depth_game_near, &fp_depth_game_far);
+    fp_quat_identity(fp_tilt_q);
+    fp_osc_reset();
+    fp_uw_yaw_vel = 0.0f;
+    fp_uw_pitch_vel = 0.0f;
+    fp_cam_reset();
+    fp_euro_reset();
+    fp_probe_valid = 0;
+    fp_config_read_all();
+    fp_capture_mode = -1;                 /* resend mouse_capture */
 
     /* Initialise yaw from player facing direction */
     fp_yaw = player_getYaw();
@@ -279,17 +1329,154 @@ static void fp_enter(void) {
     fp_last_map = map_get();
     fp_last_transformation = player_getTransformation();
 
-    if (!recomp_get_config_u32("head_tracking"))
+    if (!fp_opt[FP_OPT_HEAD_TRACKING])
         player_setModelVisible(0);
 
     mouse_set_enabled(1);
+    fp_on_enter();
+}
+
+#if FP_PROFILER
+/* ------------------------------------------------------------------ */
+/* Stage profiler — log-linear histograms, 4 buckets per power of two  */
+/* ------------------------------------------------------------------ */
+
+static void fp_prof_record(s32 stage, u32 ns) {
+    s32 b, idx;
+
+    if (ns < 4) {
+        idx = (s32)ns;
+    } else {
+        b = 31 - __builtin_clz(ns);
+        idx = b * 4 + (s32)((ns >> (b - 2)) & 3);
+    }
+    fp_prof_hist[stage][idx]++;
+    if (ns > fp_prof_max[stage])
+        fp_prof_max[stage] = ns;
+}
+
+/* Midpoint of a bucket in nanoseconds */
+static u32 fp_prof_bucket_ns(s32 idx) {
+    s32 b = idx / 4;
+
+    if (idx < 8)
+        return (u32)idx;
+    return ((u32)(4 + idx % 4) << (b - 2)) + ((1u << (b - 2)) >> 1);
+}
+
+static u32 fp_prof_percentile(const u32 *hist, u32 total, u32 permille) {
+    u32 want = (total * permille + 999) / 1000, seen = 0;
+    s32 i;
+
+    for (i = 0; i < FP_PROF_BUCKETS; i++) {
+        seen += hist[i];
+        if (seen >= want)
+            return fp_prof_bucket_ns(i);
+    }
+    return 0;
+}
+
+static void fp_prof_dump(void) {
+    u32 words[FP_PROF_STAGES * 4];
+    unsigned char *folder;
+    s32 stage, i;
+
+    for (stage = 0; stage < FP_PROF_STAGES; stage++) {
+        u32 total = 0;
+        for (i = 0; i < FP_PROF_BUCKETS; i++)
+            total += fp_prof_hist[stage][i];
+        words[stage * 4 + 0] = total;
+        words[stage * 4 + 1] = total ? fp_prof_percentile(fp_prof_hist[stage], total, 500) : 0;
+        words[stage * 4 + 2] = total ? fp_prof_percentile(fp_prof_hist[stage], total, 990) : 0;
+        words[stage * 4 + 3] = fp_prof_max[stage];
+        for (i = 0; i < FP_PROF_BUCKETS; i++)
+            fp_prof_hist[stage][i] = 0;
+        fp_prof_max[stage] = 0;
+    }
+    if (words[FP_PROF_TOTAL * 4] == 0)
+        return;
+
+    folder = recomp_get_mod_folder_path();
+    if (!folder)
+        return;
+    if (!prof_write_report(folder, words, FP_PROF_STAGES, FP_PROF_NAMES))
+        recomp_printf("[fp] could not write profile report\n");
+    recomp_free(folder);
+}
+#endif
+
+#if FP_STATS
+static void fp_stats_dump(void) {
+    s32 i;
+
+    if (fp_cull_frames > 0)
+        recomp_printf("[fp] actor culling: %u of %u actor models culled, avg %.1f/frame, max %u\n",
+                      fp_cull_culled, fp_cull_tested,
+                      (f32)fp_cull_culled / (f32)fp_cull_frames, fp_cull_max);
+    fp_cull_frames = 0;
+    fp_cull_tested = 0;
+    fp_cull_culled = 0;
+    fp_cull_max = 0;
+
+    for (i = 0; i < 8; i++) {
+        if (fp_model_draws[i] > 0)
+            recomp_printf("[fp] player model, transformation %d: %u draws, avg %u gfx commands%s\n",
+                          i, fp_model_draws[i], fp_model_cmds[i] / fp_model_draws[i],
+                          fp_opt[FP_OPT_BONES_ONLY] ? " (discarded, bones only)" : "");
+        fp_model_draws[i] = 0;
+        fp_model_cmds[i] = 0;
+    }
+
+    if (fp_vp_writes + fp_vp_skipped > 0)
+        recomp_printf("[fp] viewport FOV: %u writes, %u skipped as unchanged\n",
+                      fp_vp_writes, fp_vp_skipped);
+    fp_vp_writes = 0;
+    fp_vp_skipped = 0;
+
+    for (i = 0; i < 8; i++) {
+        if (fp_variant_frames[i] > 0)
+            recomp_printf("[fp] update variant ht=%d classic=%d mouse=%d: %u frames, avg %.2f us\n",
+                          (i >> 2) & 1, (i >> 1) & 1, i & 1, fp_variant_frames[i],
+                          (f32)fp_variant_cycles[i] * 1000000.0f / FP_COUNT_PER_SEC
+                              / (f32)fp_variant_frames[i]);
+        fp_variant_frames[i] = 0;
+        fp_variant_cycles[i] = 0;
+    }
+    if (fp_latch_frames > 0)
+        recomp_printf("[fp] late latch: %u frames, %u with new motion, avg %.2f ms newer than camera update\n",
+                      fp_latch_frames, fp_latch_moved,
+                      fp_latch_age_sum * 1000.0f / (f32)fp_latch_frames);
+    if (fp_probe_runs + fp_probe_reused > 0)
+        recomp_printf("[fp] wall probe: %u queries, %u cached, %.2f us/query, %.2f us/frame\n",
+                      fp_probe_runs, fp_probe_reused,
+                      fp_probe_runs ? (f32)fp_probe_cycles * 1000000.0f / FP_COUNT_PER_SEC / (f32)fp_probe_runs : 0.0f,
+                      (f32)fp_probe_cycles * 1000000.0f / FP_COUNT_PER_SEC
+                          / (f32)(fp_probe_runs + fp_probe_reused));
+    fp_latch_frames = 0;
+    fp_latch_moved = 0;
+    fp_latch_age_sum = 0.0f;
+    fp_probe_runs = 0;
+    fp_probe_reused = 0;
+    fp_probe_cycles = 0;
 }
+#endif
 
 static void fp_exit(void) {
+#if FP_STATS
+    fp_stats_dump();
+#endif
+#if FP_PROFILER
+    fp_prof_dump();
+#endif
     fp_active = 0;
     player_setModelVisible(1);
-    viewport_setFOVy(fp_saved_fov);
+    fp_viewport_set_fov(fp_saved_fov);
+    fp_depth_restore();
+    fp_cull_valid = 0;
     mouse_set_enabled(0);
+    fp_state.active = 0;
+    fp_state.profile = FP_PROFILE_NONE;
+    fp_on_exit();
 }
 
 /* ------------------------------------------------------------------ */
@@ -318,17 +1505,38 @@ RECOMP_CALLBACK("*", recomp_on_init) void on_init(void) {
     fp_last_transformation = 0;
     fp_prev_toggle_held    = 0;
     fp_smooth_y            = 0.0f;
-    fp_smooth_roll         = 0.0f;
-    fp_bob_phase           = 0.0f;
-    fp_bob_strength        = 0.0f;
+    fp_quat_identity(fp_tilt_q);
+    fp_osc_reset();
     fp_synth_roll          = 0.0f;
     fp_prev_yaw            = 0.0f;
     fp_saved_fov           = 0.0f;
+    fp_fov_writing         = 0;
     fp_restore_after_transition = 0;
     fp_restore_pitch       = 0.0f;
+    fp_uw_yaw_vel          = 0.0f;
+    fp_uw_pitch_vel        = 0.0f;
     fp_was_in_water        = 0;
     fp_water_exit_frames   = 0;
     fp_effective_water     = 0;
+    fp_mouse_on            = 0;
+    fp_cam_reset();
+    fp_euro_reset();
+    fp_euro_on             = 0;
+    fp_probe_valid         = 0;
+    fp_calib_session       = 0;
+    fp_calib_form          = 0;
+    fp_state.active        = 0;
+    fp_state.profile       = FP_PROFILE_NONE;
+    fp_depth_game_near     = 0.0f;
+    fp_depth_game_far      = 0.0f;
+    fp_depth_applied       = 0;
+    fp_depth_writing       = 0;
+    fp_bones_only          = 0;
+    fp_in_actor_draw       = 0;
+    fp_cull_depth          = 0;
+    fp_cull_discard        = 0;
+    fp_cull_valid          = 0;
+    fp_calib_load();
 }
 
 /* ------------------------------------------------------------------ */
@@ -341,6 +1549,110 @@ RECOMP_PATCH int bainput_should_look_first_person_camera(void) {
     return bakey_pressed(BUTTON_C_UP) && can_view_first_person();
 }
 
+/* ------------------------------------------------------------------ */
+/* HOOK — baModel_draw: bones-only player model.  Hiding the model    */
+/* with player_setModelVisible(0) stops the skeleton from updating     */
+/* (bone reads go stale, and swimming never recovers).  Instead the    */
+/* model is drawn as usual, which poses the skeleton and refreshes the */
+/* bone positions, and the display list, matrix and vertex cursors are */
+/* then rewound so none of it is sent.                                 */
+/* ------------------------------------------------------------------ */
+
+RECOMP_HOOK("baModel_draw") void before_player_draw(u8 **gfx, u8 **mtx, u8 **vtx) {
+    s32 tracked = fp_active && fp_opt[FP_OPT_HEAD_TRACKING];
+
+    fp_bones_only = tracked && fp_opt[FP_OPT_BONES_ONLY];
+    fp_model_gfx = gfx;
+    fp_model_mtx = mtx;
+    fp_model_vtx = vtx;
+    fp_model_gfx_start = *gfx;
+    fp_model_mtx_start = *mtx;
+    fp_model_vtx_start = *vtx;
+}
+
+RECOMP_HOOK_RETURN("baModel_draw") void after_player_draw(void) {
+#if FP_STATS
+    if (fp_active) {
+        u32 xform = player_getTransformation() & 7;
+        fp_model_draws[xform]++;
+        fp_model_cmds[xform] += (u32)(*fp_model_gfx - fp_model_gfx_start) / 8;
+    }
+#endif
+    if (fp_bones_only) {
+        *fp_model_gfx = fp_model_gfx_start;
+        *fp_model_mtx = fp_model_mtx_start;
+        *fp_model_vtx = fp_model_vtx_start;
+    }
+}
+
+/* Only the outermost model of a draw is tested: models drawn from inside
+ * it are rewound along with it. */
+RECOMP_HOOK("modelRender_draw") void before_model_render(u8 **gfx, u8 **mtx, f32 position[3],
+                                                         f32 rotation[3], f32 scale) {
+    if (fp_cull_depth++ != 0)
+        return;
+    fp_cull_discard = 0;
+    if (fp_in_actor_draw && fp_active && fp_cull_valid && position) {
+#if FP_STATS
+        fp_cull_tested++;
+#endif
+        if (fp_cull_sphere(position, FP_CULL_RADIUS * (scale > 1.0f ? scale : 1.0f))) {
+            fp_cull_discard = 1;
+            fp_cull_gfx = gfx;
+            fp_cull_mtx = mtx;
+            fp_cull_gfx_start = *gfx;
+            fp_cull_mtx_start = *mtx;
+        }
+    }
+}
+
+RECOMP_HOOK_RETURN("modelRender_draw") void after_model_render(void) {
+    if (--fp_cull_depth != 0)
+        return;
+    if (fp_cull_discard) {
+        *fp_cull_gfx = fp_cull_gfx_start;
+        *fp_cull_mtx = fp_cull_mtx_start;
+        fp_cull_discard = 0;
+        fp_cull_frame++;
+#if FP_STATS
+        fp_cull_culled++;
+#endif
+    }
+}
+
+/* Level geometry goes through modelRender_draw too (at the map origin),
+ * so only models drawn on behalf of an actor are culled */
+RECOMP_HOOK("actor_draw") void before_actor_draw(void) {
+    fp_in_actor_draw = 1;
+}
+
+RECOMP_HOOK_RETURN("actor_draw") void after_actor_draw(void) {
+    fp_in_actor_draw = 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* HOOK — viewport_setNearAndFar: remember the game's own depth range  */
+/* ------------------------------------------------------------------ */
+
+RECOMP_HOOK("viewport_setNearAndFar") void on_set_near_and_far(f32 near, f32 far) {
+    if (fp_depth_writing)
+        return;
+    fp_depth_game_near = near;
+    fp_depth_game_far = far;
+    fp_depth_applied = 0;                /* overwritten: re-apply next update */
+}
+
+/* ------------------------------------------------------------------ */
+/* HOOK — viewport_setFOVy: a FOV the game sets while first person is */
+/* on is the one to hand back on exit                                  */
+/* ------------------------------------------------------------------ */
+
+RECOMP_HOOK("viewport_setFOVy") void on_set_fovy(f32 fovy) {
+    if (fp_fov_writing || !fp_active)
+        return;
+    fp_saved_fov = fovy;
+}
+
 /* ------------------------------------------------------------------ */
 /* HOOK — transitionToMap: save FP state when a map transition starts  */
 /* ------------------------------------------------------------------ */
@@ -371,7 +1683,6 @@ RECOMP_HOOK_RETURN("func_802E3E7C") void on_transition_complete(void) {
 
 RECOMP_HOOK("gcpausemenu_draw") void on_pause_menu_draw(void) {
     if (fp_active && !gcpausemenu_80314B00()) {
-        mouse_set_enabled(0);
         mouse_force_show_cursor();
     }
 }
@@ -403,14 +1714,19 @@ RECOMP_HOOK("ncDynamicCamera_update") void before_camera_update(void) {
 }
 
 /* ------------------------------------------------------------------ */
-/* HOOK_RETURN (after) — ncDynamicCamera_update                        */
+/* Per-frame FP camera update.  Written once as an always-inline       */
+/* template over the settings-menu mode switches; FP_UPDATE_VARIANT    */
+/* below stamps out one copy per combination, so each copy is          */
+/* straight-line code with the untaken mode branches folded away.      */
+/* Returns 0 on the early outs (pause menu, auto exit), where nothing  */
+/* was placed and the cost says nothing about the full update.         */
 /* ------------------------------------------------------------------ */
 
-RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
+static inline __attribute__((always_inline))
+s32 fp_camera_update_impl(const s32 head_tracking, const s32 classic, const s32 cfg_mouse_enabled) {
     f32 eye_pos[3];
     f32 rotation[3];
     f32 dt;
-    s32 head_tracking;
     f32 cfg_fov, cfg_banjo_height, cfg_banjo_fwd;
     f32 cfg_trot_height, cfg_trot_fwd, cfg_flight_height, cfg_flight_fwd;
     f32 cfg_termite_height, cfg_termite_fwd, cfg_pumpkin_height, cfg_pumpkin_fwd;
@@ -423,63 +1739,68 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
     f32 cfg_banjo_roll;
     f32 cfg_banjo_pitch;
     f32 cfg_mouse_sens_x, cfg_mouse_sens_y;
-    s32 cfg_mouse_invert_y, cfg_mouse_enabled;
+    s32 cfg_mouse_invert_y;
 
     if (!fp_active)
-        return;
+        return 0;
 
-    /* Release mouse when game pause menu is open */
+    /* Release mouse when game pause menu is open (the pause menu draw
+     * hook shows the arrow, once per frame) */
     if (!gcpausemenu_80314B00()) {
-        mouse_set_enabled(0);
-        mouse_force_show_cursor();
-        return;
+        if (mouse_is_enabled())
+            mouse_set_enabled(0);
+        return 0;
     } else if (!mouse_is_enabled()) {
         /* Re-enable mouse when returning from pause */
         mouse_set_enabled(1);
     }
 
-    head_tracking = (s32)recomp_get_config_u32("head_tracking");
-
     /* --- read per-form config sliders --- */
-    cfg_fov            = (f32)recomp_get_config_double("fov");
-    cfg_banjo_height   = (f32)recomp_get_config_double("banjo_height");
-    cfg_banjo_fwd      = (f32)recomp_get_config_double("banjo_forward");
-    cfg_trot_height    = (f32)recomp_get_config_double("trot_height");
-    cfg_trot_fwd       = (f32)recomp_get_config_double("trot_forward");
-    cfg_flight_height  = (f32)recomp_get_config_double("flight_height");
-    cfg_flight_fwd     = (f32)recomp_get_config_double("flight_forward");
-    cfg_termite_height = (f32)recomp_get_config_double("termite_height");
-    cfg_termite_fwd    = (f32)recomp_get_config_double("termite_forward");
-    cfg_pumpkin_height = (f32)recomp_get_config_double("pumpkin_height");
-    cfg_pumpkin_fwd    = (f32)recomp_get_config_double("pumpkin_forward");
-    cfg_croc_height    = (f32)recomp_get_config_double("croc_height");
-    cfg_croc_fwd       = (f32)recomp_get_config_double("croc_forward");
-    cfg_walrus_height  = (f32)recomp_get_config_double("walrus_height");
-    cfg_walrus_fwd     = (f32)recomp_get_config_double("walrus_forward");
-    cfg_bee_height     = (f32)recomp_get_config_double("bee_height");
-    cfg_bee_fwd        = (f32)recomp_get_config_double("bee_forward");
-    cfg_boots_height   = (f32)recomp_get_config_double("boots_height");
-    cfg_boots_fwd      = (f32)recomp_get_config_double("boots_forward");
-    cfg_swim_surface_height = (f32)recomp_get_config_double("swim_surface_height");
-    cfg_swim_surface_fwd    = (f32)recomp_get_config_double("swim_surface_forward");
-    cfg_swim_under_height   = (f32)recomp_get_config_double("swim_under_height");
-    cfg_swim_under_fwd      = (f32)recomp_get_config_double("swim_under_forward");
-    cfg_banjo_bob_amount = (f32)recomp_get_config_double("banjo_bob");
-    cfg_banjo_roll       = (f32)recomp_get_config_double("banjo_roll");
-    cfg_banjo_pitch      = (f32)recomp_get_config_double("banjo_pitch");
-
-    cfg_mouse_sens_x   = (f32)recomp_get_config_double("mouse_sensitivity_x");
-    cfg_mouse_sens_y   = (f32)recomp_get_config_double("mouse_sensitivity_y");
-    cfg_mouse_invert_y = (s32)recomp_get_config_u32("mouse_invert_y");
-    cfg_mouse_enabled  = (s32)recomp_get_config_u32("mouse_enabled");
+    FP_PROF_BEGIN(FP_PROF_CONFIG);
+    cfg_fov            = fp_slider[FP_SLIDER_FOV];
+    cfg_banjo_height   = fp_slider[FP_SLIDER_BANJO_HEIGHT];
+    cfg_banjo_fwd      = fp_slider[FP_SLIDER_BANJO_FORWARD];
+    cfg_trot_height    = fp_slider[FP_SLIDER_TROT_HEIGHT];
+    cfg_trot_fwd       = fp_slider[FP_SLIDER_TROT_FORWARD];
+    cfg_flight_height  = fp_slider[FP_SLIDER_FLIGHT_HEIGHT];
+    cfg_flight_fwd     = fp_slider[FP_SLIDER_FLIGHT_FORWARD];
+    cfg_termite_height = fp_slider[FP_SLIDER_TERMITE_HEIGHT];
+    cfg_termite_fwd    = fp_slider[FP_SLIDER_TERMITE_FORWARD];
+    cfg_pumpkin_height = fp_slider[FP_SLIDER_PUMPKIN_HEIGHT];
+    cfg_pumpkin_fwd    = fp_slider[FP_SLIDER_PUMPKIN_FORWARD];
+    cfg_croc_height    = fp_slider[FP_SLIDER_CROC_HEIGHT];
+    cfg_croc_fwd       = fp_slider[FP_SLIDER_CROC_FORWARD];
+    cfg_walrus_height  = fp_slider[FP_SLIDER_WALRUS_HEIGHT];
+    cfg_walrus_fwd     = fp_slider[FP_SLIDER_WALRUS_FORWARD];
+    cfg_bee_height     = fp_slider[FP_SLIDER_BEE_HEIGHT];
+    cfg_bee_fwd        = fp_slider[FP_SLIDER_BEE_FORWARD];
+    cfg_boots_height   = fp_slider[FP_SLIDER_BOOTS_HEIGHT];
+    cfg_boots_fwd      = fp_slider[FP_SLIDER_BOOTS_FORWARD];
+    cfg_swim_surface_height = fp_slider[FP_SLIDER_SWIM_SURFACE_HEIGHT];
+    cfg_swim_surface_fwd    = fp_slider[FP_SLIDER_SWIM_SURFACE_FORWARD];
+    cfg_swim_under_height   = fp_slider[FP_SLIDER_SWIM_UNDER_HEIGHT];
+    cfg_swim_under_fwd      = fp_slider[FP_SLIDER_SWIM_UNDER_FORWARD];
+    cfg_banjo_bob_amount = fp_slider[FP_SLIDER_BANJO_BOB];
+    cfg_banjo_roll       = fp_slider[FP_SLIDER_BANJO_ROLL];
+    cfg_banjo_pitch      = fp_slider[FP_SLIDER_BANJO_PITCH];
+
+    cfg_mouse_sens_x   = fp_slider[FP_SLIDER_MOUSE_SENSITIVITY_X];
+    cfg_mouse_sens_y   = fp_slider[FP_SLIDER_MOUSE_SENSITIVITY_Y];
+    cfg_mouse_invert_y = (s32)fp_opt[FP_OPT_MOUSE_INVERT_Y];
+
+    fp_euro_on     = (s32)fp_opt[FP_OPT_LOOK_FILTER];
+    fp_euro_cutoff = fp_slider[FP_SLIDER_LOOK_FILTER_CUTOFF];
+    fp_euro_beta   = fp_slider[FP_SLIDER_LOOK_FILTER_BETA];
+    FP_PROF_END(FP_PROF_CONFIG);
 
     /* --- safety checks --- */
     if (fp_should_auto_exit()) {
         fp_exit();
-        return;
+        return 0;
     }
 
     /* --- compute effective water state (require both waterState AND swim animation) --- */
+    FP_PROF_BEGIN(FP_PROF_WATER);
     {
         s32 raw_water = player_getWaterState();
         s32 st = bs_getState();
@@ -490,12 +1811,13 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
         /* Only treat as swimming if both the game's water flag and animation agree */
         fp_effective_water = (raw_water != 0 && in_swim_anim) ? raw_water : 0;
     }
+    FP_PROF_END(FP_PROF_WATER);
 
     /* --- look rotation from right stick (C-buttons) --- */
+    FP_PROF_BEGIN(FP_PROF_INPUT);
     dt = time_getDelta();
 
     {
-        s32 classic = (s32)recomp_get_config_u32("camera_mode"); /* 0=Strafe, 1=Classic */
         s32 fly_state = bs_getState();
         s32 in_flight = (player_getTransformation() == TRANSFORM_BEE && fly_state == BS_BEE_FLY)
                      || fly_state == BS_FLY || fly_state == BS_BOMB;
@@ -504,51 +1826,55 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
         if (classic || in_flight) {
             /* Classic / flight: camera yaw locked to player facing direction */
             fp_yaw = player_getYaw();
+            fp_euro_reset_axis(&fp_euro[FP_EURO_STICK_X]);
         } else {
             /* Strafe: free horizontal look */
+            f32 look = 0.0f;
             if (bakey_held(BUTTON_C_LEFT))
-                fp_yaw += FP_LOOK_SPEED * dt;
+                look += FP_LOOK_SPEED * dt;
             if (bakey_held(BUTTON_C_RIGHT))
-                fp_yaw -= FP_LOOK_SPEED * dt;
+                look -= FP_LOOK_SPEED * dt;
+            fp_yaw += fp_euro_step(&fp_euro[FP_EURO_STICK_X], look, dt);
         }
 
         /* Vertical look (both modes) — suppress during egg-firing */
         if (fly_state != BS_EGG_HEAD && fly_state != BS_EGG_ASS) {
+            f32 look = 0.0f;
             if (bakey_held(BUTTON_C_UP))
-                fp_pitch -= FP_LOOK_SPEED * dt;
+                look -= FP_LOOK_SPEED * dt;
             if (bakey_held(BUTTON_C_DOWN))
-                fp_pitch += FP_LOOK_SPEED * dt;
+                look += FP_LOOK_SPEED * dt;
+            fp_pitch += fp_euro_step(&fp_euro[FP_EURO_STICK_Y], look, dt);
+        } else {
+            fp_euro_reset_axis(&fp_euro[FP_EURO_STICK_Y]);
         }
 
         /* Mouse look (additive with C-buttons) */
+        fp_mouse_on         = cfg_mouse_enabled;
+        fp_mouse_scale_x    = cfg_mouse_sens_x * 0.022f;
+        fp_mouse_scale_y    = cfg_mouse_sens_y * (cfg_mouse_invert_y ? -0.022f : 0.022f);
+        fp_mouse_yaw_free   = !(classic || in_flight);
+        fp_mouse_pitch_free = (fly_state != BS_EGG_HEAD && fly_state != BS_EGG_ASS);
         if (cfg_mouse_enabled) {
-            mouse_poll();
-            if (mouse_is_captured()) {
-                f32 mx = (f32)mouse_get_delta_x();
-                f32 my = (f32)mouse_get_delta_y();
-                f32 sx = cfg_mouse_sens_x * 0.022f;
-                f32 sy = cfg_mouse_sens_y * 0.022f;
-                if (!(classic || in_flight))
-                    fp_yaw -= mx * sx;
-                if (fly_state != BS_EGG_HEAD && fly_state != BS_EGG_ASS)
-                    fp_pitch += (cfg_mouse_invert_y ? -my : my) * sy;
-            }
+            f32 look[2];
+            fp_mouse_look(look, 0);
         }
 
         /* Underwater: spring yaw and pitch back toward player direction.
          * Surface swimming gets free look like normal movement. */
         if (fp_effective_water == 2) {
-            f32 target_yaw = player_getYaw();
-            f32 yaw_diff = target_yaw - fp_yaw;
-            if (yaw_diff > 180.0f) yaw_diff -= 360.0f;
-            if (yaw_diff < -180.0f) yaw_diff += 360.0f;
-            fp_yaw += yaw_diff * 1.5f * dt;
-            fp_pitch += (0.0f - fp_pitch) * 1.5f * dt;
+            f32 yaw_off = fp_wrap_deg(fp_yaw - player_getYaw());
+            fp_yaw += fp_spring_step(yaw_off, &fp_uw_yaw_vel, FP_UNDERWATER_SPRING, dt) - yaw_off;
+            fp_pitch = fp_spring_step(fp_pitch, &fp_uw_pitch_vel, FP_UNDERWATER_SPRING, dt);
+        } else {
+            fp_uw_yaw_vel = 0.0f;
+            fp_uw_pitch_vel = 0.0f;
         }
     }
 
     fp_yaw   = mlNormalizeAngle(fp_yaw);
     fp_pitch = fp_clamp(fp_pitch, FP_PITCH_MIN, FP_PITCH_MAX);
+    FP_PROF_END(FP_PROF_INPUT);
 
     /* --- model visibility (game re-enables it each frame) --- */
     /* With head_tracking ON, always keep model visible so bone system stays active.
@@ -577,10 +1903,10 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
     }
 
     /* --- compute eye position --- */
+    FP_PROF_BEGIN(FP_PROF_EYE);
     if (head_tracking) {
         f32 alpha;
-        s32 uses_synth_bob = 0;
-        s32 uses_synth_sway = 0;
+        const FpOscProfile *osc = 0;
         s32 uses_bone_y = 0;
         f32 smooth_speed = FP_BOB_SMOOTH;
         u32 xform = player_getTransformation();
@@ -621,16 +1947,17 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
             eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_bee_fwd;
             eye_pos[1] += cfg_bee_height;
             eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_bee_fwd;
-            uses_synth_sway = 1;
+            osc = &fp_osc_bee;
         } else if (xform == TRANSFORM_PUMPKIN) {
             /* Pumpkin: no usable bones, use player pos + offset */
             player_getPosition(eye_pos);
             eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_pumpkin_fwd;
             eye_pos[1] += cfg_pumpkin_height;
             eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_pumpkin_fwd;
-            uses_synth_bob = 1;
+            osc = &fp_osc_pumpkin;
         } else {
-            f32 bone_dx, bone_dz;
+            f32 bone_dx, bone_dz, bone[3], left;
+            s32 calib_form = 0, bone_ok = 1;
             baModel_802924E8(eye_pos);           /* animated head bone (X/Z tracking) */
 
             /* Validate bone X/Z — if too far from player, bones are stale
@@ -641,34 +1968,41 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
                 /* > 200 units away: snap to player pos */
                 eye_pos[0] = player_pos[0];
                 eye_pos[2] = player_pos[2];
+                bone_ok = 0;
             }
             /* If bone Y is far below player feet, it's stale */
             if (eye_pos[1] < player_pos[1] - 50.0f) {
                 eye_pos[1] = player_pos[1];
                 fp_smooth_y = player_pos[1] + cfg_banjo_height;
+                bone_ok = 0;
             }
+            bone[0] = eye_pos[0];
+            bone[1] = eye_pos[1];
+            bone[2] = eye_pos[2];
 
             if (xform == TRANSFORM_TERMITE) {
                 eye_pos[1] = player_pos[1] + cfg_termite_height;
                 eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_termite_fwd;
                 eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_termite_fwd;
-                uses_synth_sway = 1;
+                osc = &fp_osc_termite;
+                calib_form = TRANSFORM_TERMITE;
             } else if (xform == TRANSFORM_WASHUP) {
                 eye_pos[1] += FP_EYE_Y_BOOST + 95.0f;
                 eye_pos[0] += ml_sin_deg(fp_yaw) * 60.0f;
                 eye_pos[2] += ml_cos_deg(fp_yaw) * 60.0f;
-                uses_synth_sway = 1;
+                osc = &fp_osc_washup;
                 uses_bone_y = 1;
+                calib_form = TRANSFORM_WASHUP;
             } else if (xform == TRANSFORM_CROC) {
                 eye_pos[1] = player_pos[1] + cfg_croc_height;
                 eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_croc_fwd;
                 eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_croc_fwd;
+                calib_form = TRANSFORM_CROC;
             } else if (xform == TRANSFORM_WALRUS) {
-                /* Forward + lateral offset to align with walrus face */
-                f32 left = -10.0f;
                 eye_pos[1] = player_pos[1] + cfg_walrus_height;
-                eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_walrus_fwd - ml_cos_deg(fp_yaw) * left;
-                eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_walrus_fwd + ml_sin_deg(fp_yaw) * left;
+                eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_walrus_fwd;
+                eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_walrus_fwd;
+                calib_form = TRANSFORM_WALRUS;
             } else {
                 s32 st = bs_getState();
                 s32 in_trot = (st == BS_BTROT_IDLE || st == BS_BTROT_WALK
@@ -686,7 +2020,7 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
                     eye_pos[1] += FP_EYE_Y_BOOST + cfg_trot_height;
                     eye_pos[0] += ml_sin_deg(fp_yaw) * cfg_trot_fwd;
                     eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_trot_fwd;
-                    uses_synth_sway = 1;
+                    osc = &fp_osc_trot;
                     uses_bone_y = 1;
                 } else if (st == BS_FLY || st == BS_BOMB) {
                     /* Flying: relative offset from bone */
@@ -701,9 +2035,24 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
                     eye_pos[2] += ml_cos_deg(fp_yaw) * cfg_banjo_fwd;
                     uses_bone_y = 1;
                     smooth_speed = cfg_banjo_bob_amount;
+                    calib_form = TRANSFORM_BANJO;
                 }
             }
+
+            /* Centre the eye on the head across the body axis. The walrus
+             * head bone sits right of centre; -10 was its hand-tuned value.
+             * The shift follows the player's yaw, not the camera's: before
+             * calibration the walrus -10 turned with fp_yaw. */
+            if (calib_form) {
+                left = fp_calib_lateral(calib_form, calib_form == TRANSFORM_WALRUS ? -10.0f : 0.0f);
+                eye_pos[0] -= ml_cos_deg(player_getYaw()) * left;
+                eye_pos[2] += ml_sin_deg(player_getYaw()) * left;
+                if (fp_opt[FP_OPT_CALIBRATE] && bone_ok && bastick_getZone() == 0)
+                    fp_calib_sample(calib_form, bone, player_pos);
+            }
         }
+        FP_PROF_END(FP_PROF_EYE);
+        FP_PROF_BEGIN(FP_PROF_SMOOTH);
 
         /* Smooth Y to dampen walk-cycle bobbing (bone-tracked Y forms only).
          * Forms using absolute player-position height don't need smoothing.
@@ -712,8 +2061,7 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
         if (uses_bone_y) {
             if (fp_smooth_y == 0.0f)
                 fp_smooth_y = eye_pos[1];        /* seed on first frame */
-            alpha = smooth_speed * dt;
-            if (alpha > 1.0f) alpha = 1.0f;
+            alpha = fp_decay_alpha(smooth_speed, dt);
             fp_smooth_y += (eye_pos[1] - fp_smooth_y) * alpha;
             if (fp_smooth_y < eye_pos[1] - 12.0f)
                 fp_smooth_y = eye_pos[1] - 12.0f;  /* going uphill */
@@ -722,64 +2070,10 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
             eye_pos[1] = fp_smooth_y;
         }
 
-        /* Apply synthetic bob AFTER smoothing so the filter doesn't eat it */
-        if (uses_synth_bob)
-            eye_pos[1] += fp_synthetic_bob(dt);
-
-        /* Synthetic sway (termite + bee + trot) */
-        if (uses_synth_sway) {
-            s32 moving = (bastick_getZone() > 0);
-            if (xform == TRANSFORM_TERMITE) {
-                if (moving) {
-                    /* Walking: vertical bob like pumpkin walk */
-                    fp_bob_phase += FP_SYNTH_BOB_PUMPKIN_WALK * dt;
-                    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
-                    eye_pos[1] += ml_sin_deg(fp_bob_phase) * FP_SYNTH_BOB_PUMPKIN_AMP;
-                } else {
-                    /* Idle: side-to-side sway with downward dip in middle */
-                    f32 sway;
-                    fp_bob_phase += FP_TERMITE_SWAY_FREQ * dt;
-                    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
-                    sway = ml_sin_deg(fp_bob_phase) * FP_TERMITE_SWAY_HORIZ;
-                    eye_pos[0] += -ml_cos_deg(fp_yaw) * sway;
-                    eye_pos[2] +=  ml_sin_deg(fp_yaw) * sway;
-                    eye_pos[1] -= (ml_cos_deg(2.0f * fp_bob_phase) + 1.0f) * 0.5f * FP_TERMITE_SWAY_DIP;
-                }
-            } else if (xform == TRANSFORM_BEE || xform == TRANSFORM_WASHUP) {
-                if (moving && xform == TRANSFORM_BEE) {
-                    /* Bee walking: roll (body dip side to side) */
-                    fp_bob_phase += FP_BEE_WALK_FREQ * dt;
-                    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
-                    fp_synth_roll = ml_sin_deg(fp_bob_phase) * FP_BEE_WALK_ROLL;
-                } else if (moving && xform == TRANSFORM_WASHUP) {
-                    /* Washup walking: side-to-side sway with upward arc in middle */
-                    f32 sway;
-                    fp_bob_phase += FP_WASHUP_WALK_FREQ * dt;
-                    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
-                    sway = ml_sin_deg(fp_bob_phase) * FP_WASHUP_SWAY_HORIZ;
-                    eye_pos[0] += -ml_cos_deg(fp_yaw) * sway;
-                    eye_pos[2] +=  ml_sin_deg(fp_yaw) * sway;
-                    eye_pos[1] += (ml_cos_deg(2.0f * fp_bob_phase) + 1.0f) * 0.5f * FP_WASHUP_SWAY_VERT;
-                } else if (!moving) {
-                    /* Idle: asymmetric harmonic sway — double-left, single-right */
-                    f32 sway;
-                    fp_bob_phase += FP_BEE_IDLE_FREQ * dt;
-                    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
-                    sway = (ml_sin_deg(fp_bob_phase)
-                          + FP_BEE_IDLE_HARMONIC * ml_sin_deg(3.0f * fp_bob_phase))
-                         * (xform == TRANSFORM_WASHUP ? FP_WASHUP_IDLE_SWAY : FP_BEE_IDLE_SWAY);
-                    eye_pos[0] += -ml_cos_deg(fp_yaw) * sway;
-                    eye_pos[2] +=  ml_sin_deg(fp_yaw) * sway;
-                }
-            } else {
-                /* Talon trot: vertical bob when running */
-                if (moving) {
-                    fp_bob_phase += FP_TROT_BOB_FREQ * dt;
-                    if (fp_bob_phase >= 360.0f) fp_bob_phase -= 360.0f;
-                    eye_pos[1] += ml_sin_deg(fp_bob_phase) * FP_TROT_BOB_AMP;
-                }
-            }
-        }
+        /* Apply synthetic motion AFTER smoothing so the filter doesn't eat it */
+        if (osc)
+            fp_osc_apply(osc, bastick_getZone() > 0, dt, eye_pos);
+        FP_PROF_END(FP_PROF_SMOOTH);
     } else {
         u32 xform = player_getTransformation();
         s32 water_st = fp_effective_water;
@@ -803,81 +2097,217 @@ RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
                 default:                eye_pos[1] += cfg_banjo_height;    break;
             }
         }
+        FP_PROF_END(FP_PROF_EYE);
+    }
+
+    /* --- keep the eye out of walls and ceilings --- */
+    FP_PROF_BEGIN(FP_PROF_COLLIDE);
+    {
+        f32 player_now[3];
+        player_getPosition(player_now);
+        if (fp_opt[FP_OPT_WALL_PROBE]) {
+            player_now[1] += fp_probe_body_y[fp_current_profile()];
+            fp_probe_clip(player_now, eye_pos);
+        }
     }
+    FP_PROF_END(FP_PROF_COLLIDE);
 
-    /* --- apply to viewport --- */
+    /* --- orientation: look, body tilt and synthetic roll as quaternions --- */
+    FP_PROF_BEGIN(FP_PROF_ROTATION);
     {
         s32 fly_st = bs_getState();
         s32 bee_flying = (player_getTransformation() == TRANSFORM_BEE
                           && fly_st == BS_BEE_FLY);
         s32 banjo_flying = (fly_st == BS_FLY || fly_st == BS_BOMB);
         s32 swimming = (fp_effective_water != 0);
-        f32 model_pitch = pitch_get();
-        /* Convert 0-360 range to signed ±180 */
-        if (model_pitch > 180.0f) model_pitch -= 360.0f;
-
-        if (bee_flying || banjo_flying || swimming) {
-            /* Flight / swimming: follow model pitch (inverted) */
-            rotation[0] = fp_pitch - model_pitch;
+        f32 model_pitch = pitch_get();   /* 0..360; quaternions don't care about wrap */
+        f32 look_pitch = fp_pitch;
+        f32 view_yaw;
+        f32 q_look[4], q_tilt[4], q_roll[4];
+        s32 has_tilt = 1;
+
+        /* Tilt target: the part of the orientation derived from the body,
+         * which gets smoothed.  Model pitch during flight, swimming and
+         * rolls/flips is followed directly as part of the look. */
+        if (bee_flying || banjo_flying) {
+            /* Flight: follow model pitch (inverted), roll from yaw turn rate */
+            f32 yaw_delta = fp_wrap_deg(fp_yaw - fp_prev_yaw);
+            f32 turn_rate = (dt > 0.0001f) ? (yaw_delta / dt) : 0.0f;
+            look_pitch -= model_pitch;
+            fp_quat_axis(q_tilt, FP_AXIS_Z,
+                         fp_clamp(-turn_rate * FP_FLIGHT_ROLL_SCALE,
+                                  -FP_FLIGHT_ROLL_MAX, FP_FLIGHT_ROLL_MAX));
+        } else if (swimming) {
+            /* Swimming: follow model pitch, heavily clamp roll to reduce nausea */
+            look_pitch -= model_pitch;
+            fp_quat_axis(q_tilt, FP_AXIS_Z, fp_clamp(fp_get_body_roll(), -3.0f, 3.0f));
         } else if (head_tracking) {
-            if (model_pitch > 10.0f || model_pitch < -10.0f)
-                rotation[0] = fp_pitch + model_pitch;   /* rolls, flips, slides */
-            else
-                rotation[0] = fp_pitch + fp_clamp(fp_get_body_pitch(),
-                                                   -cfg_banjo_pitch, cfg_banjo_pitch);
+            fp_quat_axis(q_roll, FP_AXIS_Z,
+                         fp_clamp(fp_get_body_roll(), -cfg_banjo_roll, cfg_banjo_roll));
+            if (model_pitch > 10.0f && model_pitch < 350.0f) {
+                look_pitch += model_pitch;            /* rolls, flips, slides */
+                fp_quat_identity(q_tilt);
+            } else {
+                fp_quat_axis(q_tilt, FP_AXIS_X,
+                             fp_clamp(fp_get_body_pitch(), -cfg_banjo_pitch, cfg_banjo_pitch));
+            }
+            fp_quat_mul(q_tilt, q_tilt, q_roll);
         } else {
-            rotation[0] = fp_pitch;
+            has_tilt = 0;
         }
-    }
-
-    {
-        s32 state = bs_getState();
-        if (state == BS_EGG_ASS)
-            rotation[1] = mlNormalizeAngle(fp_yaw);        /* reverse view */
-        else
-            rotation[1] = mlNormalizeAngle(fp_yaw + 180.0f);
-    }
 
-    {
-        s32 fly_st2 = bs_getState();
-        s32 bee_fly = (player_getTransformation() == TRANSFORM_BEE
-                       && fly_st2 == BS_BEE_FLY);
-        s32 banjo_fly = (fly_st2 == BS_FLY || fly_st2 == BS_BOMB);
-
-        if (bee_fly || banjo_fly) {
-            /* Flight: roll based on yaw turn rate */
-            f32 yaw_delta = fp_yaw - fp_prev_yaw;
-            if (yaw_delta > 180.0f) yaw_delta -= 360.0f;
-            if (yaw_delta < -180.0f) yaw_delta += 360.0f;
-            f32 turn_rate = (dt > 0.0001f) ? (yaw_delta / dt) : 0.0f;
-            f32 target_roll = fp_clamp(-turn_rate * FP_FLIGHT_ROLL_SCALE,
-                                        -FP_FLIGHT_ROLL_MAX, FP_FLIGHT_ROLL_MAX);
-            f32 roll_alpha = FP_BOB_SMOOTH * dt;
-            if (roll_alpha > 1.0f) roll_alpha = 1.0f;
-            fp_smooth_roll += (target_roll - fp_smooth_roll) * roll_alpha;
-            rotation[2] = fp_smooth_roll + fp_synth_roll;
-        } else if (fp_effective_water != 0) {
-            /* Swimming: heavily clamp roll to reduce nausea */
-            f32 target_roll = fp_clamp(fp_get_body_roll(), -3.0f, 3.0f);
-            f32 roll_alpha = FP_BOB_SMOOTH * dt;
-            if (roll_alpha > 1.0f) roll_alpha = 1.0f;
-            fp_smooth_roll += (target_roll - fp_smooth_roll) * roll_alpha;
-            rotation[2] = fp_smooth_roll;
-        } else if (head_tracking) {
-            f32 target_roll = fp_clamp(fp_get_body_roll(), -cfg_banjo_roll, cfg_banjo_roll);
-            f32 roll_alpha = FP_BOB_SMOOTH * dt;
-            if (roll_alpha > 1.0f) roll_alpha = 1.0f;
-            fp_smooth_roll += (target_roll - fp_smooth_roll) * roll_alpha;
-            rotation[2] = fp_smooth_roll + fp_synth_roll;
+        /* One smoothing step for the whole body tilt */
+        if (has_tilt) {
+            fp_quat_slerp(fp_tilt_q, q_tilt, fp_decay_alpha(FP_BOB_SMOOTH, dt));
         } else {
-            fp_smooth_roll = 0.0f;
-            rotation[2] = fp_synth_roll;
+            fp_quat_identity(fp_tilt_q);
+        }
+
+        /* Compose pitch * tilt * synthetic roll; yaw is applied exactly
+         * afterwards since it is the outermost rotation. */
+        fp_quat_axis(q_look, FP_AXIS_X, look_pitch);
+        fp_quat_mul(q_look, q_look, fp_tilt_q);
+        if (fp_synth_roll != 0.0f) {
+            fp_quat_axis(q_roll, FP_AXIS_Z, fp_synth_roll);
+            fp_quat_mul(q_look, q_look, q_roll);
         }
+        fp_quat_to_euler(q_look, rotation);
+
+        if (bs_getState() == BS_EGG_ASS)
+            view_yaw = fp_yaw;                         /* reverse view */
+        else
+            view_yaw = fp_yaw + 180.0f;
+        rotation[1] = mlNormalizeAngle(view_yaw + rotation[1]);
+
+        fp_cam_store(view_yaw, q_look);
     }
     fp_synth_roll = 0.0f;
     fp_prev_yaw = fp_yaw;
+    FP_PROF_END(FP_PROF_ROTATION);
 
+    FP_PROF_BEGIN(FP_PROF_APPLY);
     viewport_setPosition_vec3f(eye_pos);
     viewport_setRotation_vec3f(rotation);
-    viewport_setFOVy(cfg_fov);
+    fp_viewport_set_fov(cfg_fov);
+    fp_depth_update();
+    FP_PROF_END(FP_PROF_APPLY);
+    return 1;
+}
+
+/* Index bits: head_tracking (4) | camera_mode Classic (2) | mouse_enabled (1) */
+#define FP_UPDATE_VARIANT(ht, cl, ms) \
+    static s32 fp_camera_update_##ht##cl##ms(void) { return fp_camera_update_impl(ht, cl, ms); }
+
+FP_UPDATE_VARIANT(0, 0, 0)
+FP_UPDATE_VARIANT(0, 0, 1)
+FP_UPDATE_VARIANT(0, 1, 0)
+FP_UPDATE_VARIANT(0, 1, 1)
+FP_UPDATE_VARIANT(1, 0, 0)
+FP_UPDATE_VARIANT(1, 0, 1)
+FP_UPDATE_VARIANT(1, 1, 0)
+FP_UPDATE_VARIANT(1, 1, 1)
+
+static s32 (*const fp_update_variants[8])(void) = {
+    fp_camera_update_000, fp_camera_update_001, fp_camera_update_010, fp_camera_update_011,
+    fp_camera_update_100, fp_camera_update_101, fp_camera_update_110, fp_camera_update_111,
+};
+
+/* Picked from the config cache every update, so a mode switch lands as
+ * soon as the cache has re-read it */
+static void fp_select_update_variant(void) {
+    fp_update_variant = (fp_opt[FP_OPT_HEAD_TRACKING] ? 4 : 0)
+                      | (fp_opt[FP_OPT_CAMERA_MODE]   ? 2 : 0)
+                      | (fp_opt[FP_OPT_MOUSE_ENABLED] ? 1 : 0);
+    if ((s32)fp_opt[FP_OPT_MOUSE_CAPTURE] != fp_capture_mode) {
+        fp_capture_mode = (s32)fp_opt[FP_OPT_MOUSE_CAPTURE];
+        mouse_set_capture_mode(fp_capture_mode);
+    }
+}
+
+/* ------------------------------------------------------------------ */
+/* HOOK_RETURN (after) — ncDynamicCamera_update                        */
+/* ------------------------------------------------------------------ */
+
+RECOMP_HOOK_RETURN("ncDynamicCamera_update") void after_camera_update(void) {
+#if FP_STATS
+    u32 start;
+#endif
+    s32 placed;
+
+    if (!fp_active)
+        return;
+
+#if FP_STATS
+    start = osGetCount();
+#endif
+    fp_config_step();
+    fp_select_update_variant();
+
+    FP_PROF_BEGIN(FP_PROF_TOTAL);
+    placed = fp_update_variants[fp_update_variant]();
+    if (placed)
+        FP_PROF_END(FP_PROF_TOTAL);
+
+#if FP_STATS
+    /* Pause and exit frames only cost a menu check; keep them out of
+     * the stats */
+    if (placed) {
+        fp_variant_frames[fp_update_variant]++;
+        fp_variant_cycles[fp_update_variant] += osGetCount() - start;
+    }
+#endif
+}
+
+/* ------------------------------------------------------------------ */
+/* HOOK — viewport_setRenderViewportAndPerspectiveMatrix               */
+/* Runs while the frame's display list is built, right before the     */
+/* view rotation is baked into the projection.  Re-samples the mouse   */
+/* (late latch), rebuilds the actor culling cone, then publishes the   */
+/* final camera state to other mods.                                   */
+/* ------------------------------------------------------------------ */
+
+static void fp_render_latch(void) {
+    f32 rotation[3], q[4], q_pitch[4];
+    f32 look[2];
+    f32 yaw;
+    s32 i;
+
+    if (!fp_opt[FP_OPT_MOUSE_LATE_LATCH])
+        return;
+
+    /* Position stays as the camera update wrote it */
+    yaw = fp_cam_yaw;
+    for (i = 0; i < 4; i++)
+        q[i] = fp_cam_look[i];
+
+    /* Mouse motion since the camera update is applied for real
+     * (fp_yaw / fp_pitch) and on top of this frame's view */
+    fp_mouse_look(look, 1);
+    yaw += look[0];
+    if (look[1] != 0.0f) {
+        fp_quat_axis(q_pitch, FP_AXIS_X, look[1]);
+        fp_quat_mul(q, q_pitch, q);
+    }
+
+#if FP_STATS
+    fp_latch_frames++;
+    fp_latch_age_sum += (f32)(osGetCount() - fp_cam_count) / FP_COUNT_PER_SEC;
+    if (look[0] != 0.0f || look[1] != 0.0f)
+        fp_latch_moved++;
+#endif
+
+    fp_quat_to_euler(q, rotation);
+    rotation[1] = mlNormalizeAngle(yaw + rotation[1]);
+    viewport_setRotation_vec3f(rotation);
+}
+
+RECOMP_HOOK("viewport_setRenderViewportAndPerspectiveMatrix") void before_viewport_render(void) {
+    /* Once per tick: later passes in the same frame must match the first */
+    if (!fp_active || fp_cam_render_done || !fp_cam_valid)
+        return;
+    fp_cam_render_done = 1;
+
+    fp_render_latch();
+    fp_cull_update();
+    fp_publish_state();
 }
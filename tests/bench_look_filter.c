@@ -0,0 +1,96 @@
+/*
+ * One-Euro look filter on a replayed mouse trace: how much sensor jitter
+ * each cutoff / speed-response setting removes and how far a flick
+ * trails raw input.
+ *
+ * The trace is 60 Hz counts at 0.066 deg/count (sensitivity 3), with a
+ * +-2 count jitter: a 2 s still hold, 2 s of 20 deg/s slow aim, a 0.5 s
+ * 360 deg/s flick and a 1 s hold.  Jitter is the RMS per-frame error
+ * against the intended motion over the hold and slow aim; lag is how
+ * far the filtered view trails raw input during the flick.
+ */
+
+#include "../src/fp_camera.c"
+#include "host.h"
+
+#define TRACE_FRAMES  330
+#define TRACE_SCALE   (3.0f * 0.022f)
+
+static f32 trace_dx[TRACE_FRAMES];
+static f32 trace_intent[TRACE_FRAMES];
+
+/* Fixed LCG so the trace is the same on every host */
+static int jitter(void) {
+    static const int steps[6] = { -2, -1, 0, 0, 1, 2 };
+    static unsigned int seed = 7;
+    seed = seed * 1103515245u + 12345u;
+    return steps[(seed >> 16) % 6];
+}
+
+static void make_trace(void) {
+    int i;
+
+    for (i = 0; i < TRACE_FRAMES; i++) {
+        if (i < 120)
+            trace_intent[i] = 0.0f;
+        else if (i < 240)
+            trace_intent[i] = 5.0f;
+        else if (i < 270)
+            trace_intent[i] = 91.0f;
+        else
+            trace_intent[i] = 0.0f;
+        trace_dx[i] = trace_intent[i] + (i >= 240 && i < 270 ? 0 : jitter());
+    }
+}
+
+/* Returns the fraction of jitter removed; lag_ms gets the average flick lag */
+static f64 run(s32 on, f32 cutoff, f32 beta, f64 *lag_ms) {
+    FpEuroAxis ax = { 0.0f, 0.0f };
+    f32 dt = 1.0f / 60.0f;
+    f64 raw = 0.0, filt = 0.0, err_raw = 0.0, err_filt = 0.0, lag = 0.0;
+    int i, n = 0;
+
+    fp_euro_on = on;
+    fp_euro_cutoff = cutoff;
+    fp_euro_beta = beta;
+    for (i = 0; i < TRACE_FRAMES; i++) {
+        f32 d = trace_dx[i] * TRACE_SCALE;
+        f32 out = fp_euro_step(&ax, d, dt);
+        f32 want = trace_intent[i] * TRACE_SCALE;
+
+        raw += d;
+        filt += out;
+        if ((i >= 10 && i < 120) || (i >= 135 && i < 240)) {
+            err_raw += (d - want) * (d - want);
+            err_filt += (out - want) * (out - want);
+            n++;
+        }
+        if (i >= 240 && i < 270)
+            lag += raw - filt;
+    }
+    /* 360 deg/s: one degree behind is one millisecond behind */
+    *lag_ms = lag / 30.0 / 360.0 * 1000.0;
+    return 1.0 - sqrt(err_filt / n) / sqrt(err_raw / n);
+}
+
+static const f32 cutoffs[] = { 0.5f, 1.0f, 2.0f, 4.0f };
+static const f32 betas[]   = { 0.0f, 0.01f, 0.02f, 0.05f, 0.1f };
+
+int main(void) {
+    f64 removed, lag;
+    int c, b;
+
+    make_trace();
+    removed = run(0, 1.0f, 0.0f, &lag);
+    HOST_CHECK(removed == 0.0 && lag == 0.0, "filter off must pass input through");
+
+    printf("cutoff  beta   jitter removed  flick lag\n");
+    for (c = 0; c < (int)(sizeof(cutoffs) / sizeof(cutoffs[0])); c++) {
+        for (b = 0; b < (int)(sizeof(betas) / sizeof(betas[0])); b++) {
+            removed = run(1, cutoffs[c], betas[b], &lag);
+            printf("%4.1f    %.2f   %5.1f%%         %6.1f ms\n",
+                   cutoffs[c], betas[b], removed * 100.0, lag);
+        }
+    }
+    return host_failures != 0;
+}
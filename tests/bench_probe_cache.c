@@ -0,0 +1,124 @@
+/*
+ * Wall probe cache: collision queries per frame with and without the
+ * cache, how far the cached eye strays from a fresh probe, and how
+ * close it gets to the wall (a fresh probe keeps FP_PROBE_RADIUS).
+ *
+ * The game's line test is replaced by a wall plane at x = WALL_X.  The
+ * player stands, bobs, turns and walks toward the wall at 60 fps; the
+ * eye sits 30 units ahead of Banjo's probe start point.  Turning must
+ * re-probe every frame: the eye end barely moves, the direction does.
+ */
+
+#include "../src/fp_camera.c"
+#define HOST_LINE_TEST
+#include "host.h"
+
+#define WALL_X      100.0f
+#define FRAMES      600
+
+static int queries;
+
+void *func_80309B48(f32 start[3], f32 end[3], f32 normal[3], s32 flags) {
+    f32 t;
+
+    (void)flags;
+    queries++;
+    if ((start[0] - WALL_X) * (end[0] - WALL_X) > 0.0f)
+        return 0;
+    t = (WALL_X - start[0]) / (end[0] - start[0]);
+    end[0] = WALL_X;
+    end[1] = start[1] + (end[1] - start[1]) * t;
+    end[2] = start[2] + (end[2] - start[2]) * t;
+    normal[0] = -1.0f;
+    normal[1] = 0.0f;
+    normal[2] = 0.0f;
+    return (void *)1;
+}
+
+/* Frame f of a scenario: body point and uncorrected eye */
+typedef void (*Scenario)(int f, f32 body[3], f32 eye[3]);
+
+static void place(f32 x, f32 z, f32 yaw, f32 bob, f32 body[3], f32 eye[3]) {
+    body[0] = x;
+    body[1] = fp_probe_body_y[FP_PROFILE_BANJO] + bob;
+    body[2] = z;
+    eye[0] = x + ml_sin_deg(yaw) * 30.0f;
+    eye[1] = body[1] + 20.0f;
+    eye[2] = z + ml_cos_deg(yaw) * 30.0f;
+}
+
+/* Idle next to the wall: breathing bob of half a unit */
+static void idle(int f, f32 body[3], f32 eye[3]) {
+    place(80.0f, 0.0f, 90.0f, 0.5f * ml_sin_deg(f * 3.0f), body, eye);
+}
+
+/* Turning in place next to the wall at 90 deg/s */
+static void turning(int f, f32 body[3], f32 eye[3]) {
+    place(80.0f, 0.0f, f * 1.5f, 0.0f, body, eye);
+}
+
+/* Walking along the wall at 300 units/s */
+static void walking(int f, f32 body[3], f32 eye[3]) {
+    place(80.0f, f * 5.0f, 45.0f, 2.0f * ml_sin_deg(f * 12.0f), body, eye);
+}
+
+/* Edging toward the wall at 3 units/s, stopping 30 units short */
+static void creeping(int f, f32 body[3], f32 eye[3]) {
+    place(40.0f + f * 0.05f, 0.0f, 90.0f, 0.0f, body, eye);
+}
+
+static void run(const char *name, Scenario scene) {
+    f32 body[3], eye[3], ref[3];
+    f64 err, worst = 0.0, closest = 1e9, closest_ref = 1e9;
+    int f, cached;
+
+    queries = 0;
+    fp_probe_valid = 0;
+    for (f = 0; f < FRAMES; f++) {
+        scene(f, body, eye);
+        fp_probe_clip(body, eye);
+
+        /* Same frame with the cache bypassed */
+        scene(f, body, ref);
+        cached = queries;
+        fp_probe_valid = 0;
+        {
+            s32 age = fp_probe_age;
+            f32 from[3], to[3], frac = fp_probe_frac;
+            int i;
+            for (i = 0; i < 3; i++) {
+                from[i] = fp_probe_from[i];
+                to[i] = fp_probe_to[i];
+            }
+            fp_probe_clip(body, ref);
+            for (i = 0; i < 3; i++) {
+                fp_probe_from[i] = from[i];
+                fp_probe_to[i] = to[i];
+            }
+            fp_probe_age = age;
+            fp_probe_frac = frac;
+            fp_probe_valid = 1;
+        }
+        queries = cached;
+
+        err = gu_sqrtf(fp_dist_sq(eye, ref));
+        if (err > worst)
+            worst = err;
+        if (WALL_X - eye[0] < closest)
+            closest = WALL_X - eye[0];
+        if (WALL_X - ref[0] < closest_ref)
+            closest_ref = WALL_X - ref[0];
+    }
+    printf("%-9s queries/frame %.3f (1 uncached) | eye off by up to %.2f | closest to wall %.2f cached, %.2f uncached\n",
+           name, (f64)queries / FRAMES, worst, closest, closest_ref);
+    HOST_CHECK(closest > 0.0, "%s: cached eye went through the wall", name);
+    HOST_CHECK(worst < FP_PROBE_CACHE_DIST, "%s: cached eye %.2f off a fresh probe", name, worst);
+}
+
+int main(void) {
+    run("idle", idle);
+    run("turning", turning);
+    run("walking", walking);
+    run("creeping", creeping);
+    return host_failures != 0;
+}
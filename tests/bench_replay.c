@@ -0,0 +1,88 @@
+/*
+ * bench_replay.c — late latch input age, measured through BK_MOUSE_REPLAY
+ *
+ * Builds the native library in (no display: run with DISPLAY unset so
+ * only the replay path is live), feeds it a 1000 Hz trace, and drives
+ * 60 fps frames in real time: a full poll at the camera update and,
+ * with the latch on, a second poll where the render hook runs.  Prints
+ * how old the motion was when it reached the camera, and checks both
+ * runs hand the camera every replayed pair exactly once.
+ */
+
+#include "../native/bk_mouse_input.c"
+
+#define TRACE_HZ    1000
+#define FRAME_NS    16666667L
+#define LATCH_NS    4000000L   /* update-to-render gap */
+#define FRAMES      120
+#define PAIR_DX     3
+
+static void sleep_until(uint64_t t) {
+    struct timespec ts;
+    uint64_t now;
+    while ((now = clock_now_ns()) < t) {
+        ts.tv_sec = 0;
+        ts.tv_nsec = (long)(t - now);
+        nanosleep(&ts, NULL);
+    }
+}
+
+static void run(int latch, long *total, long *replayed, double *age_ms) {
+    recomp_context ctx;
+    uint64_t t0;
+    int f;
+
+    if (replay_file)
+        fclose(replay_file);
+    replay_file = NULL;
+    replay_checked = 0;
+    replay_running = 0;
+    replay_pairs = 0;
+    replay_age_ns = 0.0;
+    replay_motion = 0.0;
+    *total = 0;
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.r4 = 1;
+    mouse_set_enabled(NULL, &ctx);
+
+    t0 = clock_now_ns();
+    for (f = 0; f < FRAMES; f++) {
+        sleep_until(t0 + (uint64_t)f * FRAME_NS);
+        mouse_poll(NULL, &ctx);
+        *total += delta_x;
+        if (latch) {
+            sleep_until(t0 + (uint64_t)f * FRAME_NS + LATCH_NS);
+            mouse_poll_latch(NULL, &ctx);
+            *total += delta_x;
+        }
+    }
+    *replayed = (long)replay_pairs * PAIR_DX;
+    *age_ms = replay_age_ns / replay_motion / 1e6;
+}
+
+int main(void) {
+    const char *path = "bench_replay.txt";
+    FILE *f = fopen(path, "w");
+    long total_off, total_on, replayed_off, replayed_on;
+    double age_off, age_on;
+    int i;
+
+    for (i = 0; i < TRACE_HZ * 3; i++)
+        fprintf(f, "%d 0\n", PAIR_DX);
+    fclose(f);
+    setenv("BK_MOUSE_REPLAY", path, 1);
+    setenv("BK_MOUSE_REPLAY_HZ", "1000", 1);
+
+    run(0, &total_off, &replayed_off, &age_off);
+    run(1, &total_on, &replayed_on, &age_on);
+    remove(path);
+
+    printf("latch off: motion %ld, age %.2f ms\n", total_off, age_off);
+    printf("latch on:  motion %ld, age %.2f ms\n", total_on, age_on);
+    if (total_off != replayed_off || total_on != replayed_on) {
+        printf("FAIL: motion lost or counted twice\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#ifndef __FP_TESTS_HOST_H__
+#define __FP_TESTS_HOST_H__
+
+/*
+ * Host checks for src/fp_camera.c.  Each test #includes the mod source
+ * and then this header, which supplies the few game functions the pure
+ * helpers call.  The rest of the game functions the mod references are
+ * stubbed below and stop the check if it ever reaches one.  A test that
+ * brings its own level line test defines HOST_LINE_TEST first.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define HOST_DEG2RAD (3.14159265358979 / 180.0)
+
+f32 ml_sin_deg(f32 deg) { return (f32)sin(deg * HOST_DEG2RAD); }
+f32 ml_cos_deg(f32 deg) { return (f32)cos(deg * HOST_DEG2RAD); }
+f32 gu_sqrtf(f32 x)     { return sqrtf(x); }
+
+f32 mlNormalizeAngle(f32 angle) {
+    while (angle >= 360.0f)
+        angle -= 360.0f;
+    while (angle < 0.0f)
+        angle += 360.0f;
+    return angle;
+}
+
+/* Game functions the pure helpers never call */
+#define HOST_UNREACHED()                                        \
+    do {                                                        \
+        printf("FAIL: game function %s reached\n", __func__);   \
+        exit(1);                                                \
+    } while (0)
+
+int  bakey_pressed(s32 button)                 { HOST_UNREACHED(); }
+u32  bakey_held(s32 button)                    { HOST_UNREACHED(); }
+int  can_view_first_person(void)               { HOST_UNREACHED(); }
+void player_getPosition(f32 dst[3])            { HOST_UNREACHED(); }
+void player_setModelVisible(s32 visible)       { HOST_UNREACHED(); }
+u32  player_getTransformation(void)            { HOST_UNREACHED(); }
+f32  player_getYaw(void)                       { HOST_UNREACHED(); }
+void yaw_set(f32 yaw)                          { HOST_UNREACHED(); }
+void yaw_setIdeal(f32 yaw)                     { HOST_UNREACHED(); }
+s32  player_getWaterState(void)                { HOST_UNREACHED(); }
+s32  player_isDead(void)                       { HOST_UNREACHED(); }
+s32  bs_getState(void)                         { HOST_UNREACHED(); }
+s32  map_get(void)                             { HOST_UNREACHED(); }
+f32  time_getDelta(void)                       { HOST_UNREACHED(); }
+void viewport_setPosition_vec3f(f32 src[3])    { HOST_UNREACHED(); }
+void viewport_setRotation_vec3f(f32 src[3])    { HOST_UNREACHED(); }
+void viewport_getRotation_vec3f(f32 dst[3])    { HOST_UNREACHED(); }
+void viewport_getPosition_vec3f(f32 dst[3])    { HOST_UNREACHED(); }
+void baModel_802924E8(f32 dst[3])              { HOST_UNREACHED(); }
+void baModel_80291A50(s32 bone_index, f32 dst[3]) { HOST_UNREACHED(); }
+f32  viewport_getFOVy(void)                    { HOST_UNREACHED(); }
+void viewport_setFOVy(f32 fovy)                { HOST_UNREACHED(); }
+void viewport_setNearAndFar(f32 near, f32 far) { HOST_UNREACHED(); }
+void viewport_getNearAndFar(f32 *near, f32 *far) { HOST_UNREACHED(); }
+int  gcpausemenu_80314B00(void)                { HOST_UNREACHED(); }
+u32  osGetCount(void)                          { HOST_UNREACHED(); }
+f32  pitch_get(void)                           { HOST_UNREACHED(); }
+s32  bastick_getZone(void)                     { HOST_UNREACHED(); }
+#ifndef HOST_LINE_TEST
+void *func_80309B48(f32 start[3], f32 end[3], f32 normal[3], s32 flags) { HOST_UNREACHED(); }
+#endif
+
+static int host_failures;
+
+#define HOST_CHECK(cond, ...)                       \
+    do {                                            \
+        if (!(cond)) {                              \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);                    \
+            printf("\n");                           \
+            host_failures++;                        \
+        }                                           \
+    } while (0)
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef __ULTRATYPES_H__
+#define __ULTRATYPES_H__
+
+/* Host stand-in for the libultra types header (see tests/Makefile) */
+typedef signed char        s8;
+typedef unsigned char      u8;
+typedef short              s16;
+typedef unsigned short     u16;
+typedef int                s32;
+typedef unsigned int       u32;
+typedef long long          s64;
+typedef unsigned long long u64;
+typedef float              f32;
+typedef double             f64;
+
+#endif
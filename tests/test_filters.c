@@ -0,0 +1,46 @@
+/*
+ * dt sweep for the exact-in-dt filters (fp_decay_alpha, fp_spring_step):
+ * the eye-Y decay and the underwater spring must follow the same curve
+ * at any frame rate.
+ */
+
+#include "../src/fp_camera.c"
+#include "host.h"
+
+static const int rates[] = { 20, 30, 60, 120, 144, 240, 360 };
+
+int main(void) {
+    f64 worst = 0.0;
+    f32 x;
+    int r;
+
+    for (x = 0.0f; x < 30.0f; x += 0.001f) {
+        f64 err = fabs(fp_exp_neg(x) - exp(-x)) / exp(-x);
+        if (err > worst)
+            worst = err;
+    }
+    printf("fp_exp_neg: max relative error %.2g over 0..30\n", worst);
+    HOST_CHECK(worst < 1e-5, "fp_exp_neg error %g", worst);
+
+    /* Decay 0 -> 10 at 6/s and spring 30 -> 0 at omega 3, sampled at
+     * t = 0.5 s and 1 s, against the closed forms */
+    for (r = 0; r < (int)(sizeof(rates) / sizeof(rates[0])); r++) {
+        int n = rates[r], i;
+        f32 dt = 1.0f / (f32)n, y = 0.0f, d = 30.0f, v = 0.0f;
+
+        for (i = 1; i <= n; i++) {
+            y += (10.0f - y) * fp_decay_alpha(FP_BOB_SMOOTH, dt);
+            d = fp_spring_step(d, &v, FP_UNDERWATER_SPRING, dt);
+            if (i * 2 == n || i == n) {
+                f64 t = (f64)i / n;
+                f64 y_ref = 10.0 * (1.0 - exp(-FP_BOB_SMOOTH * t));
+                f64 d_ref = 30.0 * (1.0 + FP_UNDERWATER_SPRING * t) * exp(-FP_UNDERWATER_SPRING * t);
+                printf("%3d fps t=%.1f: decay %.5f (ref %.5f)  spring %.5f (ref %.5f)\n",
+                       n, t, y, y_ref, d, d_ref);
+                HOST_CHECK(fabs(y - y_ref) < 1e-3, "decay at %d fps", n);
+                HOST_CHECK(fabs(d - d_ref) < 1e-3, "spring at %d fps", n);
+            }
+        }
+    }
+    return host_failures != 0;
+}